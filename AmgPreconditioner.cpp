@@ -0,0 +1,314 @@
+#include "AmgPreconditioner.h"
+
+AmgPreconditioner::AmgPreconditioner() : m_smoother_type(CHEBYSHEV_SMOOTHER), m_number_of_threads(1), m_fine_matrix(nullptr) {
+}
+
+void AmgPreconditioner::setSmootherType(SmootherType smoother_type) {
+	m_smoother_type = smoother_type;
+}
+
+void AmgPreconditioner::setThreadCount(unsigned int number_of_threads) {
+	m_number_of_threads = number_of_threads;
+}
+
+const CsrMatrix* AmgPreconditioner::getMatrix(unsigned int level) const {
+	if (level == 0)
+		return m_fine_matrix;
+
+	return &m_coarse_matrices.at(level - 1);
+}
+
+unsigned int AmgPreconditioner::getLevelCount() const {
+	return m_coarse_matrices.size() + 1;
+}
+
+double AmgPreconditioner::estimateSpectralRadius(const CsrMatrix* matrix, const Eigen::VectorXd* inverse_diagonal) const {
+	Eigen::VectorXd vector, product;
+	double norm, radius = 0;
+
+	vector.resize(matrix->getRowCount());
+	for (unsigned int i = 0; i < vector.size(); ++i)
+		vector(i) = 1. + (i % 7) * 0.1;
+	vector.normalize();
+
+	for (unsigned int i = 0; i < AMG_POWER_ITERATIONS; ++i) {
+		matrix->multiply(&vector, &product, m_number_of_threads);
+		product = product.cwiseProduct(*inverse_diagonal);
+		norm = product.norm();
+		if (norm == 0)
+			break;
+		radius = norm;
+		vector = product / norm;
+	}
+
+	return radius;
+}
+
+void AmgPreconditioner::aggregate(const CsrMatrix* matrix, vector<int>* aggregates, unsigned int* number_of_aggregates) const {
+	const vector<int>* row_ptr = matrix->getRowPtr();
+	const vector<int>* col_ids = matrix->getColIds();
+	const vector<double>* values = matrix->getValues();
+	unsigned int number_of_rows = matrix->getRowCount();
+	vector<char> is_strong(col_ids->size(), 0);
+	vector<double> diagonal(number_of_rows);
+	vector<int> first_pass_aggregates;
+	bool has_neighbours, is_free;
+	int current_col;
+
+	for (unsigned int i = 0; i < number_of_rows; ++i)
+		diagonal[i] = fabs(matrix->getValue(i, i));
+
+	parallelFor(0, number_of_rows, m_number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i)
+			for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+				int col = col_ids->at(k);
+				is_strong[k] = col != static_cast<int>(i) &&
+					fabs(values->at(k)) >= AMG_STRENGTH_THRESHOLD * sqrt(diagonal[i] * diagonal[col]);
+			}
+	});
+
+	aggregates->assign(number_of_rows, -1);
+	*number_of_aggregates = 0;
+
+	// the first pass takes the nodes whose whole strong neighbourhood is free as aggregate roots
+	for (unsigned int i = 0; i < number_of_rows; ++i) {
+		if (aggregates->at(i) != -1)
+			continue;
+
+		has_neighbours = false;
+		is_free = true;
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k)
+			if (is_strong[k]) {
+				has_neighbours = true;
+				if (aggregates->at(col_ids->at(k)) != -1) {
+					is_free = false;
+					break;
+				}
+			}
+
+		if (!has_neighbours || !is_free)
+			continue;
+
+		aggregates->at(i) = *number_of_aggregates;
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k)
+			if (is_strong[k])
+				aggregates->at(col_ids->at(k)) = *number_of_aggregates;
+
+		++(*number_of_aggregates);
+	}
+
+	// the second pass attaches the rest to a neighbouring aggregate from the first pass
+	first_pass_aggregates = *aggregates;
+	for (unsigned int i = 0; i < number_of_rows; ++i) {
+		if (aggregates->at(i) != -1)
+			continue;
+
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+			current_col = col_ids->at(k);
+			if (is_strong[k] && first_pass_aggregates[current_col] != -1) {
+				aggregates->at(i) = first_pass_aggregates[current_col];
+				break;
+			}
+		}
+	}
+
+	// the last pass groups what is left. Isolated nodes, like the ones with a constant temperature,
+	// stay out of every aggregate and are handled by the smoother alone
+	for (unsigned int i = 0; i < number_of_rows; ++i) {
+		if (aggregates->at(i) != -1)
+			continue;
+
+		has_neighbours = false;
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k)
+			if (is_strong[k])
+				has_neighbours = true;
+
+		if (!has_neighbours)
+			continue;
+
+		aggregates->at(i) = *number_of_aggregates;
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k)
+			if (is_strong[k] && aggregates->at(col_ids->at(k)) == -1)
+				aggregates->at(col_ids->at(k)) = *number_of_aggregates;
+
+		++(*number_of_aggregates);
+	}
+}
+
+void AmgPreconditioner::buildProlongator(const CsrMatrix* matrix, const Eigen::VectorXd* inverse_diagonal, double spectral_radius,
+	const vector<int>* aggregates, unsigned int number_of_aggregates, CsrMatrix* prolongator) const {
+	unsigned int number_of_rows = matrix->getRowCount();
+	double relaxation = 4. / (3. * spectral_radius);
+	vector<unsigned int> aggregate_sizes(number_of_aggregates, 0);
+	vector<int> row_ptr(number_of_rows + 1), col_ids;
+	vector<double> values;
+	CsrMatrix tentative_prolongator, smoothed_part;
+	const vector<int>* smoothed_row_ptr;
+	const vector<int>* smoothed_col_ids;
+	const vector<double>* smoothed_values;
+
+	for (unsigned int i = 0; i < number_of_rows; ++i)
+		if (aggregates->at(i) != -1)
+			++aggregate_sizes.at(aggregates->at(i));
+
+	for (unsigned int i = 0; i < number_of_rows; ++i) {
+		row_ptr[i] = col_ids.size();
+		if (aggregates->at(i) == -1)
+			continue;
+		col_ids.push_back(aggregates->at(i));
+		values.push_back(1. / sqrt(static_cast<double>(aggregate_sizes.at(aggregates->at(i)))));
+	}
+	row_ptr[number_of_rows] = col_ids.size();
+
+	tentative_prolongator.setArrays(number_of_rows, number_of_aggregates, &row_ptr, &col_ids, &values);
+
+	// P = (I - w D^-1 A) P_tent, the pattern of A * P_tent always contains the one of P_tent
+	smoothed_part.setProduct(matrix, &tentative_prolongator, m_number_of_threads);
+	smoothed_row_ptr = smoothed_part.getRowPtr();
+	smoothed_col_ids = smoothed_part.getColIds();
+	smoothed_values = smoothed_part.getValues();
+
+	row_ptr = *smoothed_row_ptr;
+	col_ids = *smoothed_col_ids;
+	values.resize(smoothed_values->size());
+
+	parallelFor(0, number_of_rows, m_number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i)
+			for (int k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+				values[k] = -relaxation * (*inverse_diagonal)(i) * smoothed_values->at(k);
+				if (col_ids[k] == aggregates->at(i))
+					values[k] += tentative_prolongator.getValue(i, col_ids[k]);
+			}
+	});
+
+	prolongator->setArrays(number_of_rows, number_of_aggregates, &row_ptr, &col_ids, &values);
+}
+
+bool AmgPreconditioner::init(const CsrMatrix* matrix) {
+	const CsrMatrix* current_matrix = matrix;
+	vector<int> aggregates;
+	unsigned int number_of_aggregates;
+	Eigen::VectorXd inverse_diagonal;
+	CsrMatrix matrix_by_prolongator;
+
+	m_fine_matrix = matrix;
+	m_coarse_matrices.clear();
+	m_prolongators.clear();
+	m_restrictors.clear();
+	m_inverse_diagonals.clear();
+	m_spectral_radii.clear();
+
+	m_coarse_matrices.reserve(AMG_MAX_LEVELS);
+	m_prolongators.reserve(AMG_MAX_LEVELS);
+	m_restrictors.reserve(AMG_MAX_LEVELS);
+
+	while (true) {
+		current_matrix->getDiagonal(&inverse_diagonal);
+		for (unsigned int i = 0; i < inverse_diagonal.size(); ++i) {
+			if (inverse_diagonal(i) <= 0)
+				return false;
+			inverse_diagonal(i) = 1. / inverse_diagonal(i);
+		}
+
+		m_inverse_diagonals.push_back(inverse_diagonal);
+		m_spectral_radii.push_back(estimateSpectralRadius(current_matrix, &inverse_diagonal));
+
+		if (current_matrix->getRowCount() <= AMG_COARSEST_SIZE || m_inverse_diagonals.size() >= AMG_MAX_LEVELS)
+			break;
+
+		aggregate(current_matrix, &aggregates, &number_of_aggregates);
+		if (number_of_aggregates == 0 || number_of_aggregates >= current_matrix->getRowCount())
+			break;
+
+		m_prolongators.push_back(CsrMatrix());
+		buildProlongator(current_matrix, &inverse_diagonal, m_spectral_radii.back(), &aggregates, number_of_aggregates, &m_prolongators.back());
+
+		m_restrictors.push_back(CsrMatrix());
+		m_restrictors.back().setTransposed(&m_prolongators.back());
+
+		matrix_by_prolongator.setProduct(current_matrix, &m_prolongators.back(), m_number_of_threads);
+		m_coarse_matrices.push_back(CsrMatrix());
+		m_coarse_matrices.back().setProduct(&m_restrictors.back(), &matrix_by_prolongator, m_number_of_threads);
+
+		current_matrix = &m_coarse_matrices.back();
+	}
+
+	m_coarse_solver.compute(current_matrix->getEigenMap());
+	if (m_coarse_solver.info() != Eigen::Success)
+		return false;
+
+	cout << "Algebraic multigrid hierarchy has " << getLevelCount() << " levels, coarsest level has "
+		<< current_matrix->getRowCount() << " unknowns" << endl << endl;
+
+	return true;
+}
+
+void AmgPreconditioner::smooth(unsigned int level, const Eigen::VectorXd* rhs, Eigen::VectorXd* result, bool is_zero_guess) const {
+	const CsrMatrix* matrix = getMatrix(level);
+	const Eigen::VectorXd* inverse_diagonal = &m_inverse_diagonals.at(level);
+	double spectral_radius = m_spectral_radii.at(level);
+	double upper_bound, lower_bound, theta, delta, sigma, rho, new_rho;
+	Eigen::VectorXd residual, direction;
+
+	if (is_zero_guess)
+		result->setZero(rhs->size());
+
+	if (m_smoother_type == JACOBI_SMOOTHER) {
+		for (unsigned int i = 0; i < AMG_JACOBI_SWEEPS; ++i) {
+			matrix->multiply(result, &residual, m_number_of_threads);
+			*result += (4. / (3. * spectral_radius)) * (*rhs - residual).cwiseProduct(*inverse_diagonal);
+		}
+		return;
+	}
+
+	// Chebyshev polynomial of D^-1 A on [radius / 30, 1.1 * radius]
+	upper_bound = 1.1 * spectral_radius;
+	lower_bound = upper_bound / 30.;
+	theta = (upper_bound + lower_bound) / 2.;
+	delta = (upper_bound - lower_bound) / 2.;
+	sigma = theta / delta;
+	rho = 1. / sigma;
+
+	matrix->multiply(result, &residual, m_number_of_threads);
+	residual = (*rhs - residual).cwiseProduct(*inverse_diagonal);
+	direction = residual / theta;
+
+	for (unsigned int i = 0; i < AMG_CHEBYSHEV_DEGREE; ++i) {
+		*result += direction;
+		if (i + 1 == AMG_CHEBYSHEV_DEGREE)
+			break;
+
+		matrix->multiply(result, &residual, m_number_of_threads);
+		residual = (*rhs - residual).cwiseProduct(*inverse_diagonal);
+		new_rho = 1. / (2. * sigma - rho);
+		direction = new_rho * rho * direction + (2. * new_rho / delta) * residual;
+		rho = new_rho;
+	}
+}
+
+void AmgPreconditioner::cycle(unsigned int level, const Eigen::VectorXd* rhs, Eigen::VectorXd* result) const {
+	const CsrMatrix* matrix = getMatrix(level);
+	Eigen::VectorXd residual, coarse_residual, coarse_correction, correction;
+
+	if (level + 1 == getLevelCount()) {
+		*result = m_coarse_solver.solve(*rhs);
+		return;
+	}
+
+	smooth(level, rhs, result, true);
+
+	matrix->multiply(result, &residual, m_number_of_threads);
+	residual = *rhs - residual;
+	m_restrictors.at(level).multiply(&residual, &coarse_residual, m_number_of_threads);
+
+	cycle(level + 1, &coarse_residual, &coarse_correction);
+
+	m_prolongators.at(level).multiply(&coarse_correction, &correction, m_number_of_threads);
+	*result += correction;
+
+	smooth(level, rhs, result, false);
+}
+
+void AmgPreconditioner::apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const {
+	cycle(0, residual, result);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include "./lib/eigen/Dense"
+#include "./lib/eigen/SparseCholesky"
+#include "CsrMatrix.h"
+#include "Preconditioner.h"
+#include "Parallel.h"
+#include "Defines.h"
+
+using namespace std;
+
+enum SmootherType {
+	JACOBI_SMOOTHER,
+	CHEBYSHEV_SMOOTHER,
+};
+
+class AmgPreconditioner : public Preconditioner {
+private:
+	SmootherType m_smoother_type;
+	unsigned int m_number_of_threads;
+	const CsrMatrix* m_fine_matrix;
+	vector<CsrMatrix> m_coarse_matrices;
+	vector<CsrMatrix> m_prolongators;
+	vector<CsrMatrix> m_restrictors;
+	vector<Eigen::VectorXd> m_inverse_diagonals;
+	vector<double> m_spectral_radii;
+	Eigen::SimplicialLLT<SparseMatrixMap> m_coarse_solver;
+
+private:
+	const CsrMatrix* getMatrix(unsigned int level) const;
+	double estimateSpectralRadius(const CsrMatrix* matrix, const Eigen::VectorXd* inverse_diagonal) const;
+	void aggregate(const CsrMatrix* matrix, vector<int>* aggregates, unsigned int* number_of_aggregates) const;
+	void buildProlongator(const CsrMatrix* matrix, const Eigen::VectorXd* inverse_diagonal, double spectral_radius,
+						  const vector<int>* aggregates, unsigned int number_of_aggregates, CsrMatrix* prolongator) const;
+	void smooth(unsigned int level, const Eigen::VectorXd* rhs, Eigen::VectorXd* result, bool is_zero_guess) const;
+	void cycle(unsigned int level, const Eigen::VectorXd* rhs, Eigen::VectorXd* result) const;
+
+public:
+	AmgPreconditioner();
+	void setSmootherType(SmootherType smoother_type);
+	void setThreadCount(unsigned int number_of_threads);
+	bool init(const CsrMatrix* matrix) override;
+	void apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const override;
+	unsigned int getLevelCount() const;
+};
@@ -0,0 +1,649 @@
+// Benchmark executable. Build it from all sources except main.cpp and MeshGenerator_main.cpp, for example
+// g++ -std=c++17 -O2 -pthread $(ls *.cpp | grep -v -E '^(main|MeshGenerator_main).cpp$') -o benchmark
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "ConfigFile.h"
+#include "DataLoader.h"
+#include "Solver.h"
+#include "Exporter.h"
+#include "Profiler.h"
+#include "MeshGenerator.h"
+#include "NodeOrdering.h"
+
+using namespace std;
+
+#define BENCHMARK_MAX_SURFACES 100
+#define BENCHMARK_DEFAULT_REPEATS 5
+#define BENCHMARK_DEFAULT_WARMUP 1
+#define BENCHMARK_DEFAULT_THRESHOLD 10.
+#define BENCHMARK_DEFAULT_MIN_TIME 1.
+#define BENCHMARK_SWEEP_STEP 0.1
+
+enum BenchmarkStatus {
+	BENCHMARK_OK = 0,
+	BENCHMARK_REGRESSION = 1,
+	BENCHMARK_ERROR = 2,
+};
+
+struct BenchmarkOptions {
+	unsigned int repeats;
+	unsigned int warmup;
+	unsigned int number_of_threads;
+	unsigned int sweep;
+	NodeOrderingType ordering_type;
+	ElementGeometryType geometry_type;
+	bool use_mesh_cache;
+	SolverType solver_type;
+	AssemblyType assembly_type;
+	StorageType storage_type;
+	PreconditionerType preconditioner_type;
+	double threshold;
+	double min_time;
+	string config_path;
+	string baseline_path;
+	string save_baseline_path;
+	string output_directory;
+	vector<string> meshes;
+	vector<array<unsigned int, COORDS_PER_NODE>> boxes;
+};
+
+// Wall times of one phase over all measured runs
+struct PhaseTimes {
+	string name;
+	unsigned int depth;
+	vector<double> wall_times;
+	vector<double> cpu_times;
+};
+
+struct PhaseResult {
+	string mesh;
+	string name;
+	unsigned int depth;
+	double median;
+	double p95;
+	double cpu_median;
+};
+
+void printUsage(const char* exe_name) {
+	cout << "Usage: " << exe_name << " [options] [mesh files]" << endl << endl
+		<< "Runs load, assembly, solve and export on every mesh and reports median and p95 wall time per phase." << endl
+		<< "Without mesh files and boxes the bundled examples from \"meshes examples\" are used." << endl << endl
+		<< "  --repeats N              measured runs per mesh (" << BENCHMARK_DEFAULT_REPEATS << ")" << endl
+		<< "  --warmup N               runs per mesh before measuring (" << BENCHMARK_DEFAULT_WARMUP << ")" << endl
+		<< "  --threads N              assembly and solver threads, 0 for all cores" << endl
+		<< "  --solver cholesky|pcg|matrix_free" << endl
+		<< "  --assembly colored|triplet  element assembly strategy (colored)" << endl
+		<< "  --storage full|upper     global matrix storage, upper keeps one triangle (full)" << endl
+		<< "  --preconditioner jacobi|ic|ssor|amg" << endl
+		<< "  --ordering rcm|hilbert|morton  renumber the nodes after loading" << endl
+		<< "  --geometry batched|jacobian|determinant  element geometry routine (jacobian)" << endl
+		<< "  --sweep N                assemble and solve N more times per run with a changed heat conduction" << endl
+		<< "  --box XxYxZ              generate a box mesh with X * Y * Z cells into the output directory" << endl
+		<< "  --cache                  load meshes through the binary mesh cache" << endl
+		<< "  --config FILE            boundary conditions in the batch config format" << endl
+		<< "  --baseline FILE          compare medians against a saved baseline" << endl
+		<< "  --save-baseline FILE     save medians as a new baseline" << endl
+		<< "  --threshold PERCENT      slowdown reported as a regression (" << BENCHMARK_DEFAULT_THRESHOLD << ")" << endl
+		<< "  --min-time MS            phases faster than this are never regressions (" << BENCHMARK_DEFAULT_MIN_TIME << ")" << endl
+		<< "  --output DIRECTORY       where the result file is exported (.)" << endl << endl
+		<< "Exit code is 0 on success, 1 if a regression was found and 2 on errors." << endl;
+}
+
+bool readUnsignedArgument(const string& text, unsigned int* value) {
+	char* end;
+	unsigned long result;
+
+	if (text.empty() || text.front() == '-')
+		return false;
+
+	result = strtoul(text.c_str(), &end, 10);
+	if (*end != '\0')
+		return false;
+
+	*value = static_cast<unsigned int>(result);
+	return true;
+}
+
+bool readDoubleArgument(const string& text, double* value) {
+	char* end;
+
+	if (text.empty())
+		return false;
+
+	*value = strtod(text.c_str(), &end);
+	return *end == '\0';
+}
+
+bool readBoxArgument(const string& text, array<unsigned int, COORDS_PER_NODE>* cells) {
+	size_t begin = 0;
+	size_t end;
+
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i) {
+		end = i + 1 < COORDS_PER_NODE ? text.find('x', begin) : text.size();
+		if (end == string::npos || !readUnsignedArgument(text.substr(begin, end - begin), &cells->at(i)))
+			return false;
+		begin = end + 1;
+	}
+
+	return true;
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkOptions* options) {
+	string argument, value;
+	array<unsigned int, COORDS_PER_NODE> cells;
+
+	options->repeats = BENCHMARK_DEFAULT_REPEATS;
+	options->warmup = BENCHMARK_DEFAULT_WARMUP;
+	options->number_of_threads = 0;
+	options->sweep = 0;
+	options->ordering_type = NO_ORDERING;
+	options->geometry_type = JACOBIAN_GEOMETRY;
+	options->use_mesh_cache = false;
+	options->solver_type = CHOLESKY_SOLVER;
+	options->assembly_type = COLORED_ASSEMBLY;
+	options->storage_type = FULL_STORAGE;
+	options->preconditioner_type = INCOMPLETE_CHOLESKY_PRECONDITIONER;
+	options->threshold = BENCHMARK_DEFAULT_THRESHOLD;
+	options->min_time = BENCHMARK_DEFAULT_MIN_TIME;
+	options->output_directory = ".";
+
+	for (int i = 1; i < argc; ++i) {
+		argument = argv[i];
+
+		if (argument.compare(0, 2, "--") != 0) {
+			options->meshes.push_back(argument);
+			continue;
+		}
+
+		if (argument == "--cache") {
+			options->use_mesh_cache = true;
+			continue;
+		}
+
+		if (argument != "--repeats" && argument != "--warmup" && argument != "--threads" && argument != "--solver" &&
+			argument != "--preconditioner" && argument != "--config" && argument != "--baseline" && argument != "--save-baseline" &&
+			argument != "--output" && argument != "--threshold" && argument != "--min-time" && argument != "--box" &&
+			argument != "--sweep" && argument != "--ordering" && argument != "--geometry" && argument != "--assembly" &&
+			argument != "--storage") {
+			cout << "Unknown option " << argument << endl;
+			return false;
+		}
+
+		if (i + 1 >= argc) {
+			cout << "Option " << argument << " needs a value" << endl;
+			return false;
+		}
+		value = argv[++i];
+
+		if (argument == "--repeats") {
+			if (!readUnsignedArgument(value, &options->repeats) || options->repeats == 0) {
+				cout << "Incorrect number of repeats" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--warmup") {
+			if (!readUnsignedArgument(value, &options->warmup)) {
+				cout << "Incorrect number of warmup runs" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--threads") {
+			if (!readUnsignedArgument(value, &options->number_of_threads)) {
+				cout << "Incorrect number of threads" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--sweep") {
+			if (!readUnsignedArgument(value, &options->sweep)) {
+				cout << "Incorrect number of sweep steps" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--ordering") {
+			if (value == "rcm")
+				options->ordering_type = RCM_ORDERING;
+			else if (value == "hilbert")
+				options->ordering_type = HILBERT_ORDERING;
+			else if (value == "morton")
+				options->ordering_type = MORTON_ORDERING;
+			else {
+				cout << "Unknown ordering \"" << value << "\"" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--geometry") {
+			if (value == "batched")
+				options->geometry_type = BATCHED_GEOMETRY;
+			else if (value == "jacobian")
+				options->geometry_type = JACOBIAN_GEOMETRY;
+			else if (value == "determinant")
+				options->geometry_type = DETERMINANT_GEOMETRY;
+			else {
+				cout << "Unknown geometry routine \"" << value << "\"" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--assembly") {
+			if (value == "colored")
+				options->assembly_type = COLORED_ASSEMBLY;
+			else if (value == "triplet")
+				options->assembly_type = TRIPLET_ASSEMBLY;
+			else {
+				cout << "Unknown assembly \"" << value << "\"" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--storage") {
+			if (value == "full")
+				options->storage_type = FULL_STORAGE;
+			else if (value == "upper")
+				options->storage_type = UPPER_STORAGE;
+			else {
+				cout << "Unknown storage \"" << value << "\"" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--solver") {
+			if (value == "cholesky")
+				options->solver_type = CHOLESKY_SOLVER;
+			else if (value == "pcg")
+				options->solver_type = PCG_SOLVER;
+			else if (value == "matrix_free")
+				options->solver_type = MATRIX_FREE_SOLVER;
+			else {
+				cout << "Unknown solver \"" << value << "\"" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--preconditioner") {
+			if (value == "jacobi")
+				options->preconditioner_type = JACOBI_PRECONDITIONER;
+			else if (value == "ic")
+				options->preconditioner_type = INCOMPLETE_CHOLESKY_PRECONDITIONER;
+			else if (value == "ssor")
+				options->preconditioner_type = SSOR_PRECONDITIONER;
+			else if (value == "amg")
+				options->preconditioner_type = AMG_PRECONDITIONER;
+			else {
+				cout << "Unknown preconditioner \"" << value << "\"" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--box") {
+			if (!readBoxArgument(value, &cells)) {
+				cout << "Incorrect box \"" << value << "\", expected cell counts like 20x20x20" << endl;
+				return false;
+			}
+			options->boxes.push_back(cells);
+		}
+		else if (argument == "--config")
+			options->config_path = value;
+		else if (argument == "--baseline")
+			options->baseline_path = value;
+		else if (argument == "--save-baseline")
+			options->save_baseline_path = value;
+		else if (argument == "--output")
+			options->output_directory = value;
+		else if (argument == "--threshold") {
+			if (!readDoubleArgument(value, &options->threshold)) {
+				cout << "Incorrect threshold" << endl;
+				return false;
+			}
+		}
+		else if (argument == "--min-time") {
+			if (!readDoubleArgument(value, &options->min_time)) {
+				cout << "Incorrect minimal time" << endl;
+				return false;
+			}
+		}
+	}
+
+	if (options->meshes.empty() && options->boxes.empty()) {
+		options->meshes.push_back("meshes examples/simple mesh.txt");
+		options->meshes.push_back("meshes examples/mesh.txt");
+		options->meshes.push_back("meshes examples/difficult mesh.txt");
+		options->meshes.push_back("meshes examples/very difficult mesh.txt");
+	}
+
+	return true;
+}
+
+// The same conditions the examples are usually checked with: surfaces cycle through
+// constant temperature, environment heat exchange, heat flow and no heat exchange
+void setDefaultConditions(ConfigFile* config) {
+	string section;
+
+	config->setValue("", "heat_conduction", "1.5");
+
+	for (unsigned int i = 0; i < BENCHMARK_MAX_SURFACES; ++i) {
+		section = "surface " + to_string(i + 1);
+
+		switch (i % 4) {
+		case 0:
+			config->setValue(section, "type", "constant_temperature");
+			config->setValue(section, "temperature", "100");
+			break;
+		case 1:
+			config->setValue(section, "type", "environment_heat_exchange");
+			config->setValue(section, "temperature", "20");
+			config->setValue(section, "exchange_coeff", "2.5");
+			break;
+		case 2:
+			config->setValue(section, "type", "heat_flow");
+			config->setValue(section, "flow", "5");
+			break;
+		default:
+			config->setValue(section, "type", "no_heat_exchange");
+			break;
+		}
+	}
+}
+
+bool runOnce(const string& mesh_path, const ConfigFile* config, const BenchmarkOptions* options, Profiler* profiler) {
+	NodeOrdering ordering;
+	DataLoader data_loader(mesh_path);
+	data_loader.setMeshCachePath(options->use_mesh_cache ? mesh_path + ".cache" : "");
+	data_loader.setConfig(config);
+	data_loader.setProfiler(profiler);
+	data_loader.setGeometryType(options->geometry_type);
+
+	profiler->beginPhase("load");
+	if (!data_loader.loadData())
+		return false;
+	profiler->endPhase();
+
+	if (options->ordering_type != NO_ORDERING) {
+		profiler->beginPhase("node ordering");
+		ordering.init(&data_loader, options->ordering_type);
+		data_loader.renumberNodes(ordering.getNewIds());
+		profiler->endPhase();
+	}
+
+	Solver solver(&data_loader);
+	solver.setProfiler(profiler);
+	solver.setThreadCount(options->number_of_threads);
+	solver.setSolverType(options->solver_type);
+	solver.setAssemblyType(options->assembly_type);
+	solver.setStorageType(options->storage_type);
+	solver.setPreconditionerType(options->preconditioner_type);
+
+	profiler->beginPhase("assembly");
+	if (!solver.setGlobalArrays())
+		return false;
+	profiler->endPhase();
+
+	if (options->sweep == 0)
+		data_loader.deleteSomeDataBeforeSolve();
+
+	profiler->beginPhase("solve");
+	if (!solver.solve())
+		return false;
+	profiler->endPhase();
+
+	// only the values of the global matrix change between sweep steps, so the solver keeps its symbolic analysis
+	double heat_conduction_coeff = data_loader.getHeatConductionCoeff();
+	for (unsigned int i = 1; i <= options->sweep; ++i) {
+		data_loader.setHeatConductionCoeff(heat_conduction_coeff * (1. + BENCHMARK_SWEEP_STEP * i));
+
+		profiler->beginPhase("sweep assembly");
+		if (!solver.setGlobalArrays())
+			return false;
+		profiler->endPhase();
+
+		profiler->beginPhase("sweep solve");
+		if (!solver.solve())
+			return false;
+		profiler->endPhase();
+	}
+
+	Exporter exporter(&data_loader, &solver);
+	exporter.setOutputDirectory(options->output_directory);
+
+	profiler->beginPhase("export");
+	if (!exporter.genetateTxtFile("/benchmark result.txt"))
+		return false;
+	profiler->endPhase();
+
+	return true;
+}
+
+void addSamples(const Profiler* profiler, vector<PhaseTimes>* phases) {
+	const ProfilerPhase* current_phase;
+	unsigned int position;
+
+	for (unsigned int i = 0; i < profiler->getPhaseCount(); ++i) {
+		current_phase = profiler->getPhase(i);
+
+		for (position = 0; position < phases->size(); ++position)
+			if (phases->at(position).name == current_phase->name)
+				break;
+
+		if (position == phases->size()) {
+			phases->push_back(PhaseTimes());
+			phases->back().name = current_phase->name;
+			phases->back().depth = current_phase->depth;
+		}
+
+		phases->at(position).wall_times.push_back((current_phase->end.wall_time - current_phase->begin.wall_time) * 1000);
+		phases->at(position).cpu_times.push_back((current_phase->end.cpu_time - current_phase->begin.cpu_time) * 1000);
+	}
+}
+
+double getPercentile(vector<double> values, double percentile) {
+	unsigned int rank;
+
+	if (values.empty())
+		return 0;
+
+	sort(values.begin(), values.end());
+
+	if (percentile == 50 && values.size() % 2 == 0)
+		return (values.at(values.size() / 2 - 1) + values.at(values.size() / 2)) / 2;
+
+	// nearest rank
+	rank = static_cast<unsigned int>(ceil(percentile / 100 * values.size()));
+	return values.at(max(rank, 1u) - 1);
+}
+
+string getMeshName(const string& mesh_path) {
+	size_t index = mesh_path.find_last_of("\\/");
+
+	if (index == string::npos)
+		return mesh_path;
+
+	return mesh_path.substr(index + 1);
+}
+
+bool runMesh(const string& mesh_path, const ConfigFile* config, const BenchmarkOptions* options, vector<PhaseResult>* results) {
+	vector<PhaseTimes> phases;
+	PhaseResult result;
+	streambuf* cout_buffer;
+	bool is_done = true;
+
+	cout << "Benchmarking " << mesh_path << ": " << options->warmup << " warmup and " << options->repeats << " measured runs" << endl;
+
+	for (unsigned int i = 0; i < options->warmup + options->repeats && is_done; ++i) {
+		Profiler profiler;
+
+		// the solver reports its progress to cout, which would only slow the runs down
+		cout_buffer = cout.rdbuf(nullptr);
+		is_done = runOnce(mesh_path, config, options, &profiler);
+		cout.rdbuf(cout_buffer);
+
+		if (is_done && i >= options->warmup)
+			addSamples(&profiler, &phases);
+	}
+
+	if (!is_done) {
+		cout << "Run failed on " << mesh_path << ", check it with the main executable" << endl << endl;
+		return false;
+	}
+
+	for (unsigned int i = 0; i < phases.size(); ++i) {
+		result.mesh = getMeshName(mesh_path);
+		result.name = phases.at(i).name;
+		result.depth = phases.at(i).depth;
+		result.median = getPercentile(phases.at(i).wall_times, 50);
+		result.p95 = getPercentile(phases.at(i).wall_times, 95);
+		result.cpu_median = getPercentile(phases.at(i).cpu_times, 50);
+		results->push_back(result);
+	}
+
+	return true;
+}
+
+// Baseline lines are "mesh <tab> phase <tab> median ms <tab> p95 ms"
+bool loadBaseline(const string& file_path, map<pair<string, string>, double>* baseline) {
+	ifstream file(file_path);
+	string line, mesh, phase, median;
+	double value;
+
+	if (!file.is_open()) {
+		cout << "Can't open baseline file " << file_path << endl;
+		return false;
+	}
+
+	while (getline(file, line)) {
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		istringstream stream(line);
+		if (!getline(stream, mesh, '\t') || !getline(stream, phase, '\t') || !getline(stream, median, '\t') ||
+			!readDoubleArgument(median, &value)) {
+			cout << "Incorrect line in baseline file: " << line << endl;
+			return false;
+		}
+
+		(*baseline)[pair<string, string>(mesh, phase)] = value;
+	}
+
+	return true;
+}
+
+bool saveBaseline(const string& file_path, const vector<PhaseResult>* results) {
+	ofstream file(file_path);
+
+	if (!file.is_open()) {
+		cout << "Can't write baseline file " << file_path << endl;
+		return false;
+	}
+
+	file << "# mesh\tphase\tmedian ms\tp95 ms" << endl << setprecision(6);
+
+	for (unsigned int i = 0; i < results->size(); ++i)
+		file << results->at(i).mesh << '\t' << results->at(i).name << '\t'
+			<< results->at(i).median << '\t' << results->at(i).p95 << endl;
+
+	return !file.fail();
+}
+
+bool printResults(const vector<PhaseResult>* results, const map<pair<string, string>, double>* baseline, const BenchmarkOptions* options) {
+	const PhaseResult* current_result;
+	map<pair<string, string>, double>::const_iterator baseline_iter;
+	string current_mesh;
+	double change;
+	bool has_regression = false;
+
+	cout << fixed << setprecision(2);
+
+	for (unsigned int i = 0; i < results->size(); ++i) {
+		current_result = &results->at(i);
+
+		if (current_result->mesh != current_mesh) {
+			current_mesh = current_result->mesh;
+			cout << endl << current_mesh << endl
+				<< left << setw(36) << "phase" << right << setw(12) << "median ms" << setw(12) << "p95 ms"
+				<< setw(12) << "cpu ms" << setw(14) << "baseline ms" << setw(10) << "change" << endl;
+		}
+
+		cout << left << setw(36) << string(2 * current_result->depth, ' ') + current_result->name << right
+			<< setw(12) << current_result->median << setw(12) << current_result->p95 << setw(12) << current_result->cpu_median;
+
+		baseline_iter = baseline->find(pair<string, string>(current_result->mesh, current_result->name));
+		if (baseline_iter == baseline->end()) {
+			cout << endl;
+			continue;
+		}
+
+		change = baseline_iter->second > 0 ? (current_result->median / baseline_iter->second - 1) * 100 : 0;
+		cout << setw(14) << baseline_iter->second << setw(9) << showpos << change << noshowpos << "%";
+
+		if (change > options->threshold && current_result->median - baseline_iter->second > options->min_time) {
+			cout << "  REGRESSION";
+			has_regression = true;
+		}
+
+		cout << endl;
+	}
+
+	cout << endl;
+
+	return has_regression;
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	ConfigFile config;
+	vector<PhaseResult> results;
+	map<pair<string, string>, double> baseline;
+	bool has_regression;
+
+	if (!parseArguments(argc, argv, &options)) {
+		printUsage(argv[0]);
+		return BENCHMARK_ERROR;
+	}
+
+	if (options.config_path.empty())
+		setDefaultConditions(&config);
+
+	else if (!config.load(options.config_path))
+		return BENCHMARK_ERROR;
+
+	if (!options.baseline_path.empty() && !loadBaseline(options.baseline_path, &baseline))
+		return BENCHMARK_ERROR;
+
+	for (unsigned int i = 0; i < options.boxes.size(); ++i) {
+		MeshGenerator generator;
+		string mesh_path = options.output_directory + "/box " + to_string(options.boxes.at(i)[0]) + "x" +
+			to_string(options.boxes.at(i)[1]) + "x" + to_string(options.boxes.at(i)[2]) + ".txt";
+
+		if (!generator.setCellCount(options.boxes.at(i)[0], options.boxes.at(i)[1], options.boxes.at(i)[2])) {
+			cout << "Box mesh " << mesh_path << " is empty or too large" << endl;
+			return BENCHMARK_ERROR;
+		}
+
+		cout << "Generating " << mesh_path << " with " << generator.getElementCount() << " elements" << endl;
+		if (!generator.writeNeutralFile(mesh_path)) {
+			cout << "Can't write box mesh " << mesh_path << endl;
+			return BENCHMARK_ERROR;
+		}
+
+		options.meshes.push_back(mesh_path);
+	}
+
+	for (unsigned int i = 0; i < options.meshes.size(); ++i)
+		if (!runMesh(options.meshes.at(i), &config, &options, &results))
+			return BENCHMARK_ERROR;
+
+	has_regression = printResults(&results, &baseline, &options);
+
+	if (!options.save_baseline_path.empty() && !saveBaseline(options.save_baseline_path, &results))
+		return BENCHMARK_ERROR;
+
+	if (has_regression) {
+		cout << "Some phases are slower than the baseline by more than " << options.threshold << "%" << endl;
+		return BENCHMARK_REGRESSION;
+	}
+
+	return BENCHMARK_OK;
+}
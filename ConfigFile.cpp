@@ -0,0 +1,136 @@
+#include "ConfigFile.h"
+
+ConfigFile::ConfigFile() {
+}
+
+string ConfigFile::trim(const string& line) {
+	size_t begin = line.find_first_not_of(" \t\r\n");
+	size_t end = line.find_last_not_of(" \t\r\n");
+
+	if (begin == string::npos)
+		return "";
+
+	return line.substr(begin, end - begin + 1);
+}
+
+bool ConfigFile::load(const string& file_path) {
+	ifstream file;
+	string line, current_section;
+	size_t separator;
+	unsigned int line_number = 0;
+
+	file.open(file_path);
+	if (!file.is_open()) {
+		cout << "Can't open the config file " << file_path << endl;
+		return false;
+	}
+
+	m_values.clear();
+
+	while (getline(file, line)) {
+		++line_number;
+
+		separator = line.find_first_of(";#");
+		if (separator != string::npos)
+			line = line.substr(0, separator);
+
+		line = trim(line);
+		if (line.empty())
+			continue;
+
+		if (line.front() == '[') {
+			if (line.back() != ']') {
+				cout << "Config file error at line " << line_number << ": unclosed section header" << endl;
+				return false;
+			}
+
+			current_section = trim(line.substr(1, line.size() - 2));
+			m_values[current_section];
+			continue;
+		}
+
+		separator = line.find('=');
+		if (separator == string::npos) {
+			cout << "Config file error at line " << line_number << ": expected key = value" << endl;
+			return false;
+		}
+
+		m_values[current_section][trim(line.substr(0, separator))] = trim(line.substr(separator + 1));
+	}
+
+	return true;
+}
+
+void ConfigFile::setValue(const string& section, const string& key, const string& value) {
+	m_values[section][key] = value;
+}
+
+bool ConfigFile::hasSection(const string& section) const {
+	return m_values.count(section) != 0;
+}
+
+bool ConfigFile::hasValue(const string& section, const string& key) const {
+	map<string, map<string, string>>::const_iterator section_iter = m_values.find(section);
+
+	if (section_iter == m_values.end())
+		return false;
+
+	return section_iter->second.count(key) != 0;
+}
+
+string ConfigFile::getString(const string& section, const string& key, const string& default_value) const {
+	if (!hasValue(section, key))
+		return default_value;
+
+	return m_values.at(section).at(key);
+}
+
+bool ConfigFile::getDouble(const string& section, const string& key, double* value) const {
+	string text = getString(section, key, "");
+	char* end;
+	double result;
+
+	if (text.empty())
+		return false;
+
+	errno = 0;
+	result = strtod(text.c_str(), &end);
+	if (*end != '\0' || errno != 0)
+		return false;
+
+	*value = result;
+	return true;
+}
+
+bool ConfigFile::getUnsigned(const string& section, const string& key, unsigned int* value) const {
+	string text = getString(section, key, "");
+	char* end;
+	unsigned long result;
+
+	if (text.empty() || text.front() == '-')
+		return false;
+
+	errno = 0;
+	result = strtoul(text.c_str(), &end, 10);
+	if (*end != '\0' || errno != 0)
+		return false;
+
+	*value = static_cast<unsigned int>(result);
+	return true;
+}
+
+bool ConfigFile::getBool(const string& section, const string& key, bool* value) const {
+	string text = getString(section, key, "");
+
+	if (text == "1" || text == "true" || text == "on" || text == "yes") {
+		*value = true;
+		return true;
+	}
+
+	if (text == "0" || text == "false" || text == "off" || text == "no") {
+		*value = false;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <map>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cerrno>
+
+using namespace std;
+
+// INI-like configuration: "key = value" lines grouped by "[section]" headers.
+// Keys before the first header belong to the section with an empty name,
+// ';' and '#' start comments
+class ConfigFile {
+private:
+	map<string, map<string, string>> m_values;
+
+private:
+	static string trim(const string& line);
+
+public:
+	ConfigFile();
+	bool load(const string& file_path);
+	void setValue(const string& section, const string& key, const string& value);
+	bool hasSection(const string& section) const;
+	bool hasValue(const string& section, const string& key) const;
+	string getString(const string& section, const string& key, const string& default_value) const;
+	bool getDouble(const string& section, const string& key, double* value) const;
+	bool getUnsigned(const string& section, const string& key, unsigned int* value) const;
+	bool getBool(const string& section, const string& key, bool* value) const;
+};
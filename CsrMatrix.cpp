@@ -0,0 +1,590 @@
+#include "CsrMatrix.h"
+
+LinearOperator::~LinearOperator() {
+}
+
+CsrMatrix::CsrMatrix() : m_number_of_rows(0), m_number_of_cols(0), m_storage_type(FULL_STORAGE) {
+}
+
+// Takes effect for the next pattern, triplets given to an upper matrix must have row <= col
+void CsrMatrix::setStorageType(StorageType storage_type) {
+	m_storage_type = storage_type;
+}
+
+void CsrMatrix::initPattern(const DataLoader* data_loader) {
+	unsigned int number_of_elements = data_loader->getElementCount();
+	unsigned int current_row, row_begin, row_end, row_size;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	vector<int> row_fill;
+	vector<int> col_candidates;
+	const int* cached_row_ptr;
+	const int* cached_col_ids;
+	unsigned int cached_size;
+
+	m_number_of_rows = data_loader->getNodeCount();
+	m_number_of_cols = m_number_of_rows;
+
+	if (data_loader->getCachedPattern(&cached_row_ptr, &cached_col_ids, &cached_size) && m_storage_type == FULL_STORAGE) {
+		m_row_ptr.assign(cached_row_ptr, cached_row_ptr + m_number_of_rows + 1);
+		m_col_ids.assign(cached_col_ids, cached_col_ids + cached_size);
+		m_values.assign(cached_size, 0.);
+		return;
+	}
+
+	// the cached pattern is full, an upper one takes the part of every row from its diagonal on
+	if (data_loader->getCachedPattern(&cached_row_ptr, &cached_col_ids, &cached_size)) {
+		m_row_ptr.assign(1, 0);
+		m_col_ids.clear();
+		for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+			for (int k = cached_row_ptr[i]; k < cached_row_ptr[i + 1]; ++k)
+				if (cached_col_ids[k] >= static_cast<int>(i))
+					m_col_ids.push_back(cached_col_ids[k]);
+			m_row_ptr.push_back(m_col_ids.size());
+		}
+		m_values.assign(m_col_ids.size(), 0.);
+		return;
+	}
+
+	m_row_ptr.assign(m_number_of_rows + 1, 0);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
+				if (m_storage_type == FULL_STORAGE || current_elem_nodes_id->at(k) <= current_elem_nodes_id->at(l))
+					++m_row_ptr.at(current_elem_nodes_id->at(k) + 1);
+	}
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i)
+		m_row_ptr.at(i + 1) += m_row_ptr.at(i);
+
+	col_candidates.resize(m_row_ptr.back());
+	row_fill.assign(m_row_ptr.begin(), m_row_ptr.end() - 1);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k) {
+			current_row = current_elem_nodes_id->at(k);
+			for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
+				if (m_storage_type == FULL_STORAGE || current_row <= current_elem_nodes_id->at(l))
+					col_candidates[row_fill[current_row]++] = current_elem_nodes_id->at(l);
+		}
+	}
+
+	m_col_ids.clear();
+	m_col_ids.reserve(col_candidates.size() / 2);
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+		row_begin = m_row_ptr[i];
+		row_end = m_row_ptr[i + 1];
+
+		sort(col_candidates.begin() + row_begin, col_candidates.begin() + row_end);
+		row_size = unique(col_candidates.begin() + row_begin, col_candidates.begin() + row_end) - col_candidates.begin() - row_begin;
+
+		m_row_ptr[i] = m_col_ids.size();
+		m_col_ids.insert(m_col_ids.end(), col_candidates.begin() + row_begin, col_candidates.begin() + row_begin + row_size);
+	}
+
+	m_row_ptr[m_number_of_rows] = m_col_ids.size();
+	m_col_ids.shrink_to_fit();
+	m_values.assign(m_col_ids.size(), 0.);
+}
+
+void CsrMatrix::setArrays(unsigned int number_of_rows, unsigned int number_of_cols,
+	vector<int>* row_ptr, vector<int>* col_ids, vector<double>* values) {
+	m_number_of_rows = number_of_rows;
+	m_number_of_cols = number_of_cols;
+	m_row_ptr.swap(*row_ptr);
+	m_col_ids.swap(*col_ids);
+	m_values.swap(*values);
+}
+
+// An entry of the radix sort, the row and the column are packed into one key
+struct KeyedEntry {
+	uint64_t key;
+	double value;
+};
+
+// One stable counting sort pass of an LSD radix sort, the digit is the key shifted right by shift.
+// Every thread counts its chunk into its own histogram and then scatters the chunk, so the chunks keep their order
+static void radixSortPass(const vector<KeyedEntry>* source, vector<KeyedEntry>* destination,
+	unsigned int shift, unsigned int digit_bits, unsigned int number_of_threads) {
+	unsigned int number_of_buckets = 1u << digit_bits;
+	uint64_t digit_mask = number_of_buckets - 1;
+	vector<unsigned int> offsets(number_of_threads * number_of_buckets, 0);
+	unsigned int position = 0;
+
+	parallelFor(0, source->size(), number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+		unsigned int* histogram = offsets.data() + thread_id * number_of_buckets;
+
+		for (unsigned int i = begin; i < end; ++i)
+			++histogram[((*source)[i].key >> shift) & digit_mask];
+	});
+
+	for (unsigned int digit = 0; digit < number_of_buckets; ++digit)
+		for (unsigned int t = 0; t < number_of_threads; ++t) {
+			position += offsets[t * number_of_buckets + digit];
+			offsets[t * number_of_buckets + digit] = position - offsets[t * number_of_buckets + digit];
+		}
+
+	parallelFor(0, source->size(), number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+		unsigned int* histogram = offsets.data() + thread_id * number_of_buckets;
+
+		for (unsigned int i = begin; i < end; ++i)
+			(*destination)[histogram[((*source)[i].key >> shift) & digit_mask]++] = (*source)[i];
+	});
+}
+
+static unsigned int getBitCount(unsigned int value) {
+	unsigned int bit_count = 0;
+
+	while (bit_count < 32 && (1u << bit_count) < value)
+		++bit_count;
+
+	return bit_count;
+}
+
+// The key of an entry is row * 2^col_bits + col. The keys are sorted with a stable LSD radix sort whose
+// digits have 8 to 11 bits, so equal entries are summed in the order of the buffers. If every thread
+// fills its buffer from a contiguous chunk of elements the result does not depend on the number of threads
+void CsrMatrix::setFromTriplets(unsigned int number_of_rows, unsigned int number_of_cols,
+	const vector<vector<CooEntry>>* entries, unsigned int number_of_threads) {
+	vector<KeyedEntry> sorted, buffer;
+	vector<unsigned int> unique_rows;
+	vector<unsigned int> buffer_offsets(entries->size() + 1, 0);
+	vector<unsigned int> chunk_offsets(number_of_threads + 1, 0);
+	unsigned int col_bits = getBitCount(number_of_cols);
+	unsigned int key_bits = max(1u, getBitCount(number_of_rows) + col_bits);
+	unsigned int number_of_passes = (key_bits + RADIX_MAX_DIGIT_BITS - 1) / RADIX_MAX_DIGIT_BITS;
+	unsigned int digit_bits = max(static_cast<unsigned int>(RADIX_MIN_DIGIT_BITS), (key_bits + number_of_passes - 1) / number_of_passes);
+	uint64_t col_mask = (static_cast<uint64_t>(1) << col_bits) - 1;
+	unsigned int size;
+
+	for (unsigned int t = 0; t < entries->size(); ++t)
+		buffer_offsets[t + 1] = buffer_offsets[t] + entries->at(t).size();
+
+	size = buffer_offsets.back();
+	sorted.resize(size);
+	buffer.resize(size);
+
+	parallelFor(0, entries->size(), number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int t = begin; t < end; ++t)
+			for (unsigned int i = 0; i < entries->at(t).size(); ++i) {
+				const CooEntry* entry = &entries->at(t)[i];
+				sorted[buffer_offsets[t] + i] = KeyedEntry{ (static_cast<uint64_t>(entry->row) << col_bits) | entry->col, entry->value };
+			}
+	});
+
+	for (unsigned int pass = 0; pass < number_of_passes; ++pass) {
+		radixSortPass(&sorted, &buffer, pass * digit_bits, digit_bits, number_of_threads);
+		sorted.swap(buffer);
+	}
+
+	buffer.clear();
+	buffer.shrink_to_fit();
+
+	// a chunk starts at the first entry of a new key, so the duplicates of one key stay in one chunk
+	auto isKeyBegin = [&](unsigned int i) {
+		return i == 0 || i == size || sorted[i].key != sorted[i - 1].key;
+	};
+	auto getChunkBegin = [&](unsigned int i) {
+		while (!isKeyBegin(i))
+			++i;
+		return i;
+	};
+
+	parallelFor(0, size, number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+		for (unsigned int i = getChunkBegin(begin); i < getChunkBegin(end); ++i)
+			if (isKeyBegin(i))
+				++chunk_offsets[thread_id + 1];
+	});
+
+	for (unsigned int t = 0; t < number_of_threads; ++t)
+		chunk_offsets[t + 1] += chunk_offsets[t];
+
+	m_number_of_rows = number_of_rows;
+	m_number_of_cols = number_of_cols;
+	m_col_ids.resize(chunk_offsets.back());
+	m_values.resize(chunk_offsets.back());
+	unique_rows.resize(chunk_offsets.back());
+
+	parallelFor(0, size, number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+		int position = chunk_offsets[thread_id] - 1;
+
+		for (unsigned int i = getChunkBegin(begin); i < getChunkBegin(end); ++i) {
+			if (isKeyBegin(i)) {
+				++position;
+				unique_rows[position] = sorted[i].key >> col_bits;
+				m_col_ids[position] = sorted[i].key & col_mask;
+				m_values[position] = 0;
+			}
+			m_values[position] += sorted[i].value;
+		}
+	});
+
+	m_row_ptr.resize(m_number_of_rows + 1);
+	parallelFor(0, m_number_of_rows + 1, number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i)
+			m_row_ptr[i] = lower_bound(unique_rows.begin(), unique_rows.end(), i) - unique_rows.begin();
+	});
+}
+
+void CsrMatrix::setProduct(const CsrMatrix* left, const CsrMatrix* right, unsigned int number_of_threads) {
+	const vector<int>* left_row_ptr = left->getRowPtr();
+	const vector<int>* left_col_ids = left->getColIds();
+	const vector<double>* left_values = left->getValues();
+	const vector<int>* right_row_ptr = right->getRowPtr();
+	const vector<int>* right_col_ids = right->getColIds();
+	const vector<double>* right_values = right->getValues();
+
+	m_number_of_rows = left->getRowCount();
+	m_number_of_cols = right->getColCount();
+	m_row_ptr.assign(m_number_of_rows + 1, 0);
+
+	// the first pass counts the entries of every row, the second one fills them in
+	parallelFor(0, m_number_of_rows, number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		vector<int> marker(m_number_of_cols, -1);
+		int current_col, row_size;
+
+		for (unsigned int i = begin; i < end; ++i) {
+			row_size = 0;
+			for (int k = left_row_ptr->at(i); k < left_row_ptr->at(i + 1); ++k)
+				for (int l = right_row_ptr->at(left_col_ids->at(k)); l < right_row_ptr->at(left_col_ids->at(k) + 1); ++l) {
+					current_col = right_col_ids->at(l);
+					if (marker[current_col] != static_cast<int>(i)) {
+						marker[current_col] = i;
+						++row_size;
+					}
+				}
+			m_row_ptr[i + 1] = row_size;
+		}
+	});
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i)
+		m_row_ptr[i + 1] += m_row_ptr[i];
+
+	m_col_ids.resize(m_row_ptr.back());
+	m_values.resize(m_row_ptr.back());
+
+	parallelFor(0, m_number_of_rows, number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		vector<int> position(m_number_of_cols, -1);
+		vector<pair<int, double>> row;
+		int current_col, row_end;
+		double left_value;
+
+		for (unsigned int i = begin; i < end; ++i) {
+			row_end = m_row_ptr[i];
+			for (int k = left_row_ptr->at(i); k < left_row_ptr->at(i + 1); ++k) {
+				left_value = left_values->at(k);
+				for (int l = right_row_ptr->at(left_col_ids->at(k)); l < right_row_ptr->at(left_col_ids->at(k) + 1); ++l) {
+					current_col = right_col_ids->at(l);
+					if (position[current_col] < m_row_ptr[i]) {
+						position[current_col] = row_end;
+						m_col_ids[row_end] = current_col;
+						m_values[row_end] = 0;
+						++row_end;
+					}
+					m_values[position[current_col]] += left_value * right_values->at(l);
+				}
+			}
+
+			row.clear();
+			for (int k = m_row_ptr[i]; k < row_end; ++k)
+				row.push_back(pair<int, double>(m_col_ids[k], m_values[k]));
+
+			sort(row.begin(), row.end());
+
+			for (unsigned int k = 0; k < row.size(); ++k) {
+				m_col_ids[m_row_ptr[i] + k] = row.at(k).first;
+				m_values[m_row_ptr[i] + k] = row.at(k).second;
+			}
+		}
+	});
+}
+
+void CsrMatrix::setTransposed(const CsrMatrix* matrix) {
+	const vector<int>* row_ptr = matrix->getRowPtr();
+	const vector<int>* col_ids = matrix->getColIds();
+	const vector<double>* values = matrix->getValues();
+	vector<int> row_fill;
+	int position;
+
+	m_number_of_rows = matrix->getColCount();
+	m_number_of_cols = matrix->getRowCount();
+	m_row_ptr.assign(m_number_of_rows + 1, 0);
+	m_col_ids.resize(col_ids->size());
+	m_values.resize(values->size());
+
+	for (unsigned int k = 0; k < col_ids->size(); ++k)
+		++m_row_ptr[col_ids->at(k) + 1];
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i)
+		m_row_ptr[i + 1] += m_row_ptr[i];
+
+	row_fill.assign(m_row_ptr.begin(), m_row_ptr.end() - 1);
+
+	for (unsigned int i = 0; i < m_number_of_cols; ++i)
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+			position = row_fill[col_ids->at(k)]++;
+			m_col_ids[position] = i;
+			m_values[position] = values->at(k);
+		}
+}
+
+// An entry below the diagonal of an upper matrix is found at its mirrored position
+int CsrMatrix::findOffset(unsigned int i, unsigned int j) const {
+	if (m_storage_type == UPPER_STORAGE && i > j)
+		swap(i, j);
+
+	vector<int>::const_iterator row_begin = m_col_ids.begin() + m_row_ptr[i];
+	vector<int>::const_iterator row_end = m_col_ids.begin() + m_row_ptr[i + 1];
+	vector<int>::const_iterator iter = lower_bound(row_begin, row_end, static_cast<int>(j));
+
+	if (iter == row_end || *iter != static_cast<int>(j))
+		return -1;
+
+	return iter - m_col_ids.begin();
+}
+
+void CsrMatrix::getElementOffsets(const array<unsigned int, NODES_PER_ELEMENT>* nodes_id, ElementOffsets* offsets) const {
+	for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+		for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
+			offsets->at(k * NODES_PER_ELEMENT + l) = findOffset(nodes_id->at(k), nodes_id->at(l));
+}
+
+void CsrMatrix::addToOffset(int offset, double value) {
+	m_values[offset] += value;
+}
+
+void CsrMatrix::addValue(unsigned int i, unsigned int j, double value) {
+	m_values[findOffset(i, j)] += value;
+}
+
+void CsrMatrix::setValue(unsigned int i, unsigned int j, double value) {
+	m_values[findOffset(i, j)] = value;
+}
+
+double CsrMatrix::getValue(unsigned int i, unsigned int j) const {
+	int offset = findOffset(i, j);
+
+	if (offset < 0)
+		return 0.;
+
+	return m_values[offset];
+}
+
+void CsrMatrix::setZero() {
+	fill(m_values.begin(), m_values.end(), 0.);
+}
+
+// The pattern is copied, the values are scaled in one pass
+void CsrMatrix::setScaled(double coeff, const CsrMatrix* matrix) {
+	const vector<double>* values = matrix->getValues();
+
+	m_number_of_rows = matrix->getRowCount();
+	m_number_of_cols = matrix->getColCount();
+	m_storage_type = matrix->getStorageType();
+	m_row_ptr = *matrix->getRowPtr();
+	m_col_ids = *matrix->getColIds();
+	m_values.resize(values->size());
+
+	for (unsigned int k = 0; k < m_values.size(); ++k)
+		m_values[k] = coeff * (*values)[k];
+}
+
+// Both matrices must have the pattern of this one
+void CsrMatrix::setLinearCombination(double first_coeff, const CsrMatrix* first, double second_coeff, const CsrMatrix* second) {
+	const vector<double>* first_values = first->getValues();
+	const vector<double>* second_values = second->getValues();
+
+	for (unsigned int k = 0; k < m_values.size(); ++k)
+		m_values[k] = first_coeff * first_values->at(k) + second_coeff * second_values->at(k);
+}
+
+void CsrMatrix::setRowsZero(const vector<bool>* rows) {
+	for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+		if (!rows->at(i))
+			continue;
+
+		for (int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k)
+			m_values[k] = 0.;
+	}
+}
+
+void CsrMatrix::removeOffDiagonalEntries(const vector<bool>* rows_and_cols) {
+	unsigned int new_offset = 0;
+	int row_begin = 0;
+	unsigned int current_col;
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+		for (int k = row_begin; k < m_row_ptr[i + 1]; ++k) {
+			current_col = m_col_ids[k];
+
+			if (current_col != i && (rows_and_cols->at(i) || rows_and_cols->at(current_col)))
+				continue;
+
+			m_col_ids[new_offset] = current_col;
+			m_values[new_offset] = m_values[k];
+			++new_offset;
+		}
+
+		row_begin = m_row_ptr[i + 1];
+		m_row_ptr[i + 1] = new_offset;
+	}
+
+	m_col_ids.resize(new_offset);
+	m_values.resize(new_offset);
+}
+
+// Same as removeOffDiagonalEntries, but the entries stay in the pattern as explicit zeros
+void CsrMatrix::zeroOffDiagonalEntries(const vector<bool>* rows_and_cols) {
+	unsigned int current_col;
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i)
+		for (int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k) {
+			current_col = m_col_ids[k];
+
+			if (current_col != i && (rows_and_cols->at(i) || rows_and_cols->at(current_col)))
+				m_values[k] = 0.;
+		}
+}
+
+// Keeps only the rows and columns with a non-negative new id and renumbers them. The new ids
+// must keep the order of the old ones, then the column ids of every row stay sorted
+void CsrMatrix::condense(const vector<int>* new_ids, unsigned int new_size) {
+	unsigned int new_offset = 0;
+	unsigned int new_row = 0;
+	unsigned int row_begin = 0;
+	unsigned int row_end;
+	int current_col;
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+		row_end = m_row_ptr[i + 1];
+
+		if (new_ids->at(i) < 0) {
+			row_begin = row_end;
+			continue;
+		}
+
+		for (unsigned int k = row_begin; k < row_end; ++k) {
+			current_col = new_ids->at(m_col_ids[k]);
+
+			if (current_col < 0)
+				continue;
+
+			m_col_ids[new_offset] = current_col;
+			m_values[new_offset] = m_values[k];
+			++new_offset;
+		}
+
+		row_begin = row_end;
+		m_row_ptr[++new_row] = new_offset;
+	}
+
+	m_number_of_rows = new_size;
+	m_number_of_cols = new_size;
+	m_row_ptr.resize(new_size + 1);
+	m_col_ids.resize(new_offset);
+	m_values.resize(new_offset);
+}
+
+// An upper matrix adds every stored entry to two rows. Every thread sums its chunk of rows into a private
+// vector, the first thread directly into the result. The private vectors are added in thread order and
+// zeroed again for the next product
+void CsrMatrix::multiply(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const {
+	result->resize(m_number_of_rows);
+
+	if (m_storage_type == UPPER_STORAGE) {
+		if (m_accumulators.size() < number_of_threads || (m_accumulators.size() != 0 && m_accumulators[0].size() != m_number_of_rows))
+			m_accumulators.assign(max(number_of_threads, static_cast<unsigned int>(m_accumulators.size())), Eigen::VectorXd::Zero(m_number_of_rows));
+
+		result->setZero();
+
+		parallelFor(0, m_number_of_rows, number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+			Eigen::VectorXd* accumulator = thread_id == 0 ? result : &m_accumulators[thread_id];
+			int current_col;
+
+			for (unsigned int i = begin; i < end; ++i)
+				for (int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k) {
+					current_col = m_col_ids[k];
+					(*accumulator)(i) += m_values[k] * (*x)(current_col);
+					if (current_col != static_cast<int>(i))
+						(*accumulator)(current_col) += m_values[k] * (*x)(i);
+				}
+		});
+
+		if (number_of_threads <= 1)
+			return;
+
+		parallelFor(0, m_number_of_rows, number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+			for (unsigned int t = 1; t < number_of_threads; ++t)
+				for (unsigned int i = begin; i < end; ++i) {
+					(*result)(i) += m_accumulators[t](i);
+					m_accumulators[t](i) = 0;
+				}
+		});
+		return;
+	}
+
+	parallelFor(0, m_number_of_rows, number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		double accumulator;
+
+		for (unsigned int i = begin; i < end; ++i) {
+			accumulator = 0;
+			for (int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k)
+				accumulator += m_values[k] * (*x)(m_col_ids[k]);
+			(*result)(i) = accumulator;
+		}
+	});
+}
+
+void CsrMatrix::getDiagonal(Eigen::VectorXd* diagonal) const {
+	diagonal->resize(m_number_of_rows);
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i)
+		(*diagonal)(i) = getValue(i, i);
+}
+
+void CsrMatrix::clear() {
+	m_number_of_rows = 0;
+	m_number_of_cols = 0;
+	m_row_ptr.clear();
+	m_col_ids.clear();
+	m_values.clear();
+	m_row_ptr.shrink_to_fit();
+	m_col_ids.shrink_to_fit();
+	m_values.shrink_to_fit();
+	m_accumulators.clear();
+}
+
+unsigned int CsrMatrix::getRowCount() const {
+	return m_number_of_rows;
+}
+
+unsigned int CsrMatrix::getColCount() const {
+	return m_number_of_cols;
+}
+
+unsigned int CsrMatrix::getNonZeroCount() const {
+	return m_values.size();
+}
+
+StorageType CsrMatrix::getStorageType() const {
+	return m_storage_type;
+}
+
+const vector<int>* CsrMatrix::getRowPtr() const {
+	return &m_row_ptr;
+}
+
+const vector<int>* CsrMatrix::getColIds() const {
+	return &m_col_ids;
+}
+
+const vector<double>* CsrMatrix::getValues() const {
+	return &m_values;
+}
+
+SparseMatrixMap CsrMatrix::getEigenMap() const {
+	return SparseMatrixMap(m_number_of_rows, m_number_of_rows, m_values.size(), m_row_ptr.data(), m_col_ids.data(), m_values.data());
+}
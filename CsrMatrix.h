@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "./lib/eigen/SparseCore"
+#include "./lib/eigen/Dense"
+#include "DataLoader.h"
+#include "Parallel.h"
+#include "Defines.h"
+
+using namespace std;
+
+// The matrix is symmetric, so its CSR arrays are also valid CSC arrays and can be
+// handed to the column-major Eigen solvers as they are
+typedef Eigen::Map<const Eigen::SparseMatrix<double>> SparseMatrixMap;
+
+// An upper matrix keeps only the entries with i <= j. Read as CSC it is the lower triangle,
+// which is the one the Eigen Cholesky solvers take as a self-adjoint matrix
+enum StorageType {
+	FULL_STORAGE,
+	UPPER_STORAGE,
+};
+
+// One (row, col, value) contribution, duplicates are summed when the matrix is built
+struct CooEntry {
+	unsigned int row;
+	unsigned int col;
+	double value;
+};
+
+// Offsets of the 16 values the local matrix of an element is added to, row by row. In an upper
+// matrix both entries of a symmetric pair have the offset of the stored one
+typedef array<int, NODES_PER_ELEMENT * NODES_PER_ELEMENT> ElementOffsets;
+
+// Anything the conjugate gradient method can multiply a vector by. An operator may keep scratch vectors
+// for multiply, like an upper CsrMatrix or the matrix-free operator, so one operator must not run two
+// products at the same time
+class LinearOperator {
+public:
+	virtual ~LinearOperator();
+	virtual void multiply(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const = 0;
+};
+
+class CsrMatrix : public LinearOperator {
+private:
+	unsigned int m_number_of_rows;
+	unsigned int m_number_of_cols;
+	StorageType m_storage_type;
+	vector<int> m_row_ptr;
+	vector<int> m_col_ids;
+	vector<double> m_values;
+	// per-thread sums of the upper storage product, see LinearOperator
+	mutable vector<Eigen::VectorXd> m_accumulators;
+
+public:
+	CsrMatrix();
+	void setStorageType(StorageType storage_type);
+	void initPattern(const DataLoader* data_loader);
+	void setArrays(unsigned int number_of_rows, unsigned int number_of_cols,
+				   vector<int>* row_ptr, vector<int>* col_ids, vector<double>* values);
+	void setFromTriplets(unsigned int number_of_rows, unsigned int number_of_cols,
+						 const vector<vector<CooEntry>>* entries, unsigned int number_of_threads);
+	void setProduct(const CsrMatrix* left, const CsrMatrix* right, unsigned int number_of_threads);
+	void setTransposed(const CsrMatrix* matrix);
+	int findOffset(unsigned int i, unsigned int j) const;
+	void getElementOffsets(const array<unsigned int, NODES_PER_ELEMENT>* nodes_id, ElementOffsets* offsets) const;
+	void addToOffset(int offset, double value);
+	void addValue(unsigned int i, unsigned int j, double value);
+	void setValue(unsigned int i, unsigned int j, double value);
+	double getValue(unsigned int i, unsigned int j) const;
+	void setZero();
+	void setScaled(double coeff, const CsrMatrix* matrix);
+	void setLinearCombination(double first_coeff, const CsrMatrix* first, double second_coeff, const CsrMatrix* second);
+	void setRowsZero(const vector<bool>* rows);
+	void removeOffDiagonalEntries(const vector<bool>* rows_and_cols);
+	void zeroOffDiagonalEntries(const vector<bool>* rows_and_cols);
+	void condense(const vector<int>* new_ids, unsigned int new_size);
+	void multiply(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const override;
+	void getDiagonal(Eigen::VectorXd* diagonal) const;
+	void clear();
+	unsigned int getRowCount() const;
+	unsigned int getColCount() const;
+	unsigned int getNonZeroCount() const;
+	StorageType getStorageType() const;
+	const vector<int>* getRowPtr() const;
+	const vector<int>* getColIds() const;
+	const vector<double>* getValues() const;
+	SparseMatrixMap getEigenMap() const;
+};
@@ -1,325 +1,969 @@
-#include "DataLoader.h"
-
-void DataLoader::initHeatConduction() {
-	cout << "Input heat conduction coefficient of the material: ";
-	cin >> m_heat_conduction_coeff;
-	system("cls");
-}
-
-void DataLoader::initCoords() {
-	unsigned int  number_of_nodes;
-	double coord_value;
-	string buffer_string;
-	array<double, COORDS_PER_NODE> current_coords;
-
-	m_file >> buffer_string;
-	number_of_nodes = atol(buffer_string.c_str());
-
-	for (unsigned int i = 0; i < number_of_nodes; ++i) {
-		m_file >> buffer_string;
-		coord_value = atof(buffer_string.c_str());
-		current_coords.at(0) = coord_value;
-		if (m_max_coord < fabs(coord_value))
-			m_max_coord = fabs(coord_value);
-
-		m_file >> buffer_string;
-		coord_value = atof(buffer_string.c_str());
-		current_coords.at(1) = coord_value;
-		if (m_max_coord < fabs(coord_value))
-			m_max_coord = fabs(coord_value);
-
-		m_file >> buffer_string;
-		coord_value = atof(buffer_string.c_str());
-		current_coords.at(2) = coord_value;
-		if (m_max_coord < fabs(coord_value))
-			m_max_coord = fabs(coord_value);
-
-		m_coords.push_back(current_coords);
-	}
-}
-
-void DataLoader::initElements() {
-	unsigned int  number_of_elements;
-	string buffer_string;
-	array<unsigned int, NODES_PER_ELEMENT>  indices;
-	const array<double, COORDS_PER_NODE>* elem_center;
-
-	m_file >> buffer_string;
-	number_of_elements = atol(buffer_string.c_str());
-
-	for (unsigned int i = 0; i < number_of_elements; ++i) {
-		m_file >> buffer_string;
-		m_file >> buffer_string;
-		indices.at(0) = atol(buffer_string.c_str()) - 1;
-		m_file >> buffer_string;
-		indices.at(1) = atol(buffer_string.c_str()) - 1;
-		m_file >> buffer_string;
-		indices.at(2) = atol(buffer_string.c_str()) - 1;
-		m_file >> buffer_string;
-		indices.at(3) = atol(buffer_string.c_str()) - 1;
-
-		m_elements.push_back(FiniteElement(i, &indices, &m_coords));
-
-		elem_center = m_elements.at(i).getCenter();
-		m_object_center.at(0) += elem_center->at(0);
-		m_object_center.at(1) += elem_center->at(1);
-		m_object_center.at(2) += elem_center->at(2);
-	}
-
-	m_object_center.at(0) /= number_of_elements;
-	m_object_center.at(1) /= number_of_elements;
-	m_object_center.at(2) /= number_of_elements;
-}
-
-void DataLoader::initEdges() {
-	unsigned int  number_of_edges, surface_id;
-	unsigned int  number_of_surfaces = 0;
-	unsigned int  key;
-	string buffer_string;
-	array<unsigned int, NODES_PER_EDGE>  indices;
-	pair<unsigned int, unsigned int > new_hash_table_elem;
-
-	m_file >> buffer_string;
-	number_of_edges = atol(buffer_string.c_str());
-
-	for (unsigned int i = 0; i < number_of_edges; ++i) {
-		m_file >> buffer_string;
-		surface_id = atol(buffer_string.c_str()) - 1;
-
-		if (surface_id > number_of_surfaces)
-			number_of_surfaces = surface_id;
-
-		m_file >> buffer_string;
-		indices.at(0) = atol(buffer_string.c_str()) - 1;
-		m_file >> buffer_string;
-		indices.at(1) = atol(buffer_string.c_str()) - 1;
-		m_file >> buffer_string;
-		indices.at(2) = atol(buffer_string.c_str()) - 1;
-
-		m_boundary_edges.push_back(Edge(surface_id, &indices, &m_coords));
-
-		key = generateKey(&indices);
-
-		new_hash_table_elem.first = key;
-		new_hash_table_elem.second = i;
-		m_boundary_edges_hash_table.insert(new_hash_table_elem);
-
-		if (m_node_examples.count(surface_id) == 0)
-			m_node_examples[surface_id] = indices;
-	}
-}
-
-bool DataLoader::initSufaces() {
-	unsigned int  current_node_id, condition_type, number_of_surfaces;
-	double temperature, heat_flow, exchange_coeff;
-	array<unsigned int, NODES_PER_EDGE> nodes_id;
-	array<double, COORDS_PER_NODE> node_coord;
-	Condition* condition = nullptr;
-
-	number_of_surfaces = m_node_examples.size();
-
-	m_surfaces.resize(number_of_surfaces);
-
-	for (unsigned int i = 0; i < number_of_surfaces; ++i) {
-		system("cls");
-		cout << "Input conditions at surface " << i + 1 << endl << "Three nodes that beint to this surface:" << endl << endl;
-		nodes_id = m_node_examples.at(i);
-		for (unsigned int j = 0; j < NODES_PER_EDGE; ++j) {
-			current_node_id = nodes_id.at(j);
-			node_coord = m_coords.at(current_node_id);
-			cout << nodes_id.at(j) << " : " << node_coord.at(0) << ", " << node_coord.at(1) << ", " << node_coord.at(2) << ";" << endl;
-		}
-
-		cout << endl << "Input type of the condition:" << endl << "1 = constant temperature" << endl << "2 = no heat exchange"
-			<< endl << "3 = heat flow" << endl << "4 = environment heat exchange" << endl << endl;
-		cin >> condition_type;
-
-		switch (condition_type)
-		{
-		case 1: {
-			cout << endl << "Input the temperature: ";
-			cin >> temperature;
-			condition = static_cast<Condition*>(new ConstantTempCondition(temperature));
-			Surface surface(i, condition);
-			m_surfaces.at(i) = surface;
-		}
-			  break;
-
-		case 2: {
-			condition = static_cast<Condition*>(new NoHeatExchangeCondition());
-			Surface surface(i, condition);
-			m_surfaces.at(i) = surface;
-		}
-			  break;
-
-		case 3: {
-			cout << endl << "Input the flow value: ";
-			cin >> heat_flow;
-			condition = static_cast<Condition*>(new HeatFlowCondition(heat_flow));
-			Surface surface(i, condition);
-			m_surfaces.at(i) = surface;
-		}
-			  break;
-
-		case 4: {
-			cout << endl << "Input the environment temperature: ";
-			cin >> temperature;
-			cout << endl << "Input the heat exchange coefficient: ";
-			cin >> exchange_coeff;
-			condition = static_cast<Condition*>(new EnvironmentHeatExchangeCondition(temperature, exchange_coeff));
-			Surface surface(i, condition);
-			m_surfaces.at(i) = surface;
-		}
-			  break;
-
-		default:
-			return false;
-		}
-	}
-
-	system("cls");
-
-	m_node_examples.clear();
-
-	return true;
-}
-
-unsigned int  DataLoader::generateKey(array<unsigned int, NODES_PER_EDGE>* indices) {
-	sort(indices->begin(), indices->end());
-	return (indices->at(0) * indices->at(0) + indices->at(1) * indices->at(1) + indices->at(2) * indices->at(2)) % UINT32_MAX;
-}
-
-DataLoader::DataLoader(const string& file_path) : m_max_coord(0), m_heat_conduction_coeff(DBL_MIN) {
-	m_object_center.fill(0);
-	m_file.open(file_path);
-}
-
-DataLoader::~DataLoader() {
-	for (unsigned int i = 0; i < m_surfaces.size(); ++i)
-		m_surfaces.at(i).deleteCondition();
-}
-
-bool DataLoader::loadData()
-{
-	if (!m_file.is_open()) {
-		cout << "Can't open the file!" << endl;
-		return false;
-	}
-
-	cout << "Loading nodes... " << endl << endl;
-	initCoords();
-	cout << "Loading elements... " << endl << endl;
-	initElements();
-	cout << "Loading boundary edges... " << endl << endl;
-	initEdges();
-	system("cls");
-
-	m_file.close();
-
-	initHeatConduction();
-
-	if (!initSufaces()) {
-		cout << "Incorrect condition type!" << endl;
-		return false;
-	}
-
-	cout << "Data loaded: " << getNodeCount() << " nodes, " << getElementCount()
-		<< " elements and " << getSurfaceCount() << " surfaces" << endl << endl;
-
-	return true;
-}
-
-const FiniteElement* DataLoader::getElement(unsigned int  id) const {
-	return &(m_elements.at(id));
-}
-
-const array<double, COORDS_PER_NODE>* DataLoader::getNodeCoord(unsigned int  id) const {
-	return &(m_coords.at(id));
-}
-
-const Edge* DataLoader::getIfBoundary(array<unsigned int, COORDS_PER_NODE>* indices)  const {
-	const unsigned int  key = generateKey(indices);
-	const array<unsigned int, NODES_PER_EDGE>* edge_nodes_ids;
-	array<unsigned int, NODES_PER_EDGE>::const_iterator id_iter;
-	multimap<unsigned int, unsigned int >::const_iterator hash_table_iter;
-	const Edge* current_edge;
-	unsigned int  current_edge_id;
-
-	if (m_boundary_edges_hash_table.count(key)) {
-		hash_table_iter = m_boundary_edges_hash_table.find(key);
-
-		for (; hash_table_iter->first == key; ++hash_table_iter) {
-			current_edge_id = hash_table_iter->second;
-			current_edge = &m_boundary_edges.at(current_edge_id);
-			edge_nodes_ids = current_edge->getRightIdsOrder();
-
-			id_iter = std::find(edge_nodes_ids->begin(), edge_nodes_ids->end(), indices->at(0));
-			if (id_iter == edge_nodes_ids->end())
-				continue;
-
-			id_iter = std::find(edge_nodes_ids->begin(), edge_nodes_ids->end(), indices->at(1));
-			if (id_iter == edge_nodes_ids->end())
-				continue;
-
-			id_iter = std::find(edge_nodes_ids->begin(), edge_nodes_ids->end(), indices->at(2));
-			if (id_iter == edge_nodes_ids->end())
-				continue;
-
-			return current_edge;
-		}
-
-		return nullptr;
-	}
-
-	else
-		return nullptr;
-}
-
-const Surface* DataLoader::getSurface(unsigned int  id) const {
-	return &(m_surfaces.at(id));
-}
-
-double DataLoader::getHeatConductionCoeff() const {
-	return m_heat_conduction_coeff;
-}
-
-unsigned int  DataLoader::getNodeCount() const {
-	return m_coords.size();
-}
-
-unsigned int  DataLoader::getElementCount() const {
-	return m_elements.size();
-}
-
-unsigned int  DataLoader::getSurfaceCount() const {
-	return m_surfaces.size();
-}
-
-double DataLoader::getMaxCoord() const {
-	return m_max_coord;
-}
-
-vector<unsigned int > DataLoader::getBoundaryNodes() const
-{
-	vector<unsigned int > result;
-	const array<unsigned int, NODES_PER_EDGE>* current_edge_node_ids;
-
-	for (unsigned int i = 0; i < m_boundary_edges.size(); ++i) {
-		current_edge_node_ids = m_boundary_edges.at(i).getRightIdsOrder();
-		result.push_back(current_edge_node_ids->at(0));
-		result.push_back(current_edge_node_ids->at(1));
-		result.push_back(current_edge_node_ids->at(2));
-	}
-
-	return result;
-}
-
-void DataLoader::deleteSomeDataBeforeSolve() {
-	m_elements.clear();
-	m_boundary_edges_hash_table.clear();
-	m_surfaces.clear();
-}
-
-const array<double, COORDS_PER_NODE>* DataLoader::getObjectCenter() const {
-	return &m_object_center;
-}
+#include "DataLoader.h"
+#include "CsrMatrix.h"
+
+void DataLoader::clearScreen() const {
+	if (m_config != nullptr)
+		return;
+
+#ifdef _WIN32
+	system("cls");
+#else
+	system("clear");
+#endif
+}
+
+bool DataLoader::initHeatConduction() {
+	if (m_config != nullptr) {
+		if (!m_config->getDouble("", "heat_conduction", &m_heat_conduction_coeff) || m_heat_conduction_coeff <= 0) {
+			cout << "Config file has no correct heat_conduction value!" << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	cout << "Input heat conduction coefficient of the material: ";
+	cin >> m_heat_conduction_coeff;
+	clearScreen();
+
+	return true;
+}
+
+bool DataLoader::readUnsigned(unsigned int* value) {
+	from_chars_result result;
+
+	while (m_cursor < m_file_end && isspace(static_cast<unsigned char>(*m_cursor)))
+		++m_cursor;
+
+	result = from_chars(m_cursor, m_file_end, *value);
+	if (result.ec != errc())
+		return false;
+
+	m_cursor = result.ptr;
+	return true;
+}
+
+bool DataLoader::readDouble(double* value) {
+	from_chars_result result;
+
+	while (m_cursor < m_file_end && isspace(static_cast<unsigned char>(*m_cursor)))
+		++m_cursor;
+
+	if (m_cursor < m_file_end && *m_cursor == '+')
+		++m_cursor;
+
+	result = from_chars(m_cursor, m_file_end, *value);
+	if (result.ec != errc())
+		return false;
+
+	m_cursor = result.ptr;
+	return true;
+}
+
+bool DataLoader::initCoords() {
+	ProfilerScope scope(m_profiler, "parse nodes");
+	unsigned int  number_of_nodes;
+	array<double, COORDS_PER_NODE> current_coords;
+
+	if (!readUnsigned(&number_of_nodes))
+		return false;
+
+	m_coords.reserve(number_of_nodes);
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		for (unsigned int j = 0; j < COORDS_PER_NODE; ++j) {
+			if (!readDouble(&current_coords[j]))
+				return false;
+
+			if (m_max_coord < fabs(current_coords[j]))
+				m_max_coord = fabs(current_coords[j]);
+		}
+
+		m_coords.push_back(current_coords);
+	}
+
+	return true;
+}
+
+void DataLoader::addElement(const array<unsigned int, NODES_PER_ELEMENT>* indices, const double* geometry) {
+	const array<double, COORDS_PER_NODE>* elem_center;
+
+	if (geometry == nullptr)
+		m_elements.push_back(FiniteElement(m_elements.size(), indices, &m_coords, m_geometry_type));
+
+	else
+		m_elements.push_back(FiniteElement(m_elements.size(), indices, geometry));
+
+	elem_center = m_elements.back().getCenter();
+	m_object_center.at(0) += elem_center->at(0);
+	m_object_center.at(1) += elem_center->at(1);
+	m_object_center.at(2) += elem_center->at(2);
+}
+
+void DataLoader::addBoundaryEdge(unsigned int surface_id, array<unsigned int, NODES_PER_EDGE>* indices) {
+	m_boundary_edges.push_back(Edge(surface_id, indices, &m_coords));
+	m_boundary_edges_hash_table.insert(indices, m_boundary_edges.size() - 1);
+
+	if (m_node_examples.count(surface_id) == 0)
+		m_node_examples[surface_id] = *indices;
+}
+
+bool DataLoader::initElements(vector<array<unsigned int, NODES_PER_ELEMENT>>* elements_nodes_id) {
+	ProfilerScope scope(m_profiler, "parse elements");
+	unsigned int  number_of_elements, domain_id;
+	array<unsigned int, NODES_PER_ELEMENT>  indices;
+
+	if (!readUnsigned(&number_of_elements))
+		return false;
+
+	elements_nodes_id->reserve(number_of_elements);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		if (!readUnsigned(&domain_id))
+			return false;
+
+		for (unsigned int j = 0; j < NODES_PER_ELEMENT; ++j) {
+			if (!readUnsigned(&indices[j]) || indices[j] == 0 || indices[j] > m_coords.size())
+				return false;
+			--indices[j];
+		}
+
+		elements_nodes_id->push_back(indices);
+	}
+
+	return true;
+}
+
+// The last batch is padded with its first element, the padding lanes are not stored
+void DataLoader::initBatchedGeometry(const vector<array<unsigned int, NODES_PER_ELEMENT>>* elements_nodes_id) {
+	unsigned int number_of_elements = elements_nodes_id->size();
+	unsigned int batch_size, node_id;
+	ElementBatchCoords batch_coords;
+	ElementBatchGeometry batch_geometry;
+	double geometry[ELEMENT_GEOMETRY_SIZE];
+
+	for (unsigned int first = 0; first < number_of_elements; first += ELEMENT_BATCH_SIZE) {
+		batch_size = min(number_of_elements - first, (unsigned int)ELEMENT_BATCH_SIZE);
+
+		for (unsigned int lane = 0; lane < ELEMENT_BATCH_SIZE; ++lane) {
+			for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+				node_id = elements_nodes_id->at(first + (lane < batch_size ? lane : 0)).at(i);
+				batch_coords.x[i][lane] = m_coords.at(node_id).at(0);
+				batch_coords.y[i][lane] = m_coords.at(node_id).at(1);
+				batch_coords.z[i][lane] = m_coords.at(node_id).at(2);
+			}
+		}
+
+		ElementKernels::computeGeometry(&batch_coords, &batch_geometry);
+
+		for (unsigned int lane = 0; lane < batch_size; ++lane) {
+			for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+				geometry[i] = batch_geometry.a[i][lane];
+				geometry[NODES_PER_ELEMENT + i] = batch_geometry.b[i][lane];
+				geometry[2 * NODES_PER_ELEMENT + i] = batch_geometry.c[i][lane];
+				geometry[3 * NODES_PER_ELEMENT + i] = batch_geometry.d[i][lane];
+			}
+
+			geometry[4 * NODES_PER_ELEMENT] = batch_geometry.volume[lane];
+
+			for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+				geometry[4 * NODES_PER_ELEMENT + 1 + i] = batch_geometry.center[i][lane];
+
+			addElement(&elements_nodes_id->at(first + lane), geometry);
+		}
+	}
+}
+
+void DataLoader::initGeometry(const vector<array<unsigned int, NODES_PER_ELEMENT>>* elements_nodes_id) {
+	ProfilerScope scope(m_profiler, "element geometry");
+	unsigned int number_of_elements = elements_nodes_id->size();
+
+	m_elements.reserve(number_of_elements);
+
+	if (m_geometry_type == BATCHED_GEOMETRY)
+		initBatchedGeometry(elements_nodes_id);
+
+	else
+		for (unsigned int i = 0; i < number_of_elements; ++i)
+			addElement(&elements_nodes_id->at(i), nullptr);
+
+	m_object_center.at(0) /= number_of_elements;
+	m_object_center.at(1) /= number_of_elements;
+	m_object_center.at(2) /= number_of_elements;
+}
+
+bool DataLoader::initEdges() {
+	ProfilerScope scope(m_profiler, "parse boundary edges");
+	unsigned int  number_of_edges, surface_id;
+	array<unsigned int, NODES_PER_EDGE>  indices;
+
+	if (!readUnsigned(&number_of_edges))
+		return false;
+
+	m_boundary_edges.reserve(number_of_edges);
+	m_boundary_edges_hash_table.reserve(number_of_edges);
+
+	for (unsigned int i = 0; i < number_of_edges; ++i) {
+		if (!readUnsigned(&surface_id) || surface_id == 0)
+			return false;
+		--surface_id;
+
+		for (unsigned int j = 0; j < NODES_PER_EDGE; ++j) {
+			if (!readUnsigned(&indices[j]) || indices[j] == 0 || indices[j] > m_coords.size())
+				return false;
+			--indices[j];
+		}
+
+		addBoundaryEdge(surface_id, &indices);
+	}
+
+	return true;
+}
+
+bool DataLoader::loadMeshCache(const string& file_path, bool check_source) {
+	ProfilerScope scope(m_profiler, "read mesh cache");
+	const MeshCacheHeader* header;
+	const uint32_t* elements;
+	const uint32_t* edges;
+	const double* geometry;
+	const int32_t* row_ptr;
+	const int32_t* col_ids;
+	array<unsigned int, NODES_PER_ELEMENT> element_indices;
+	array<unsigned int, NODES_PER_EDGE> edge_indices;
+	bool is_pattern_valid = true;
+
+	if (!m_mesh_cache.open(file_path))
+		return false;
+
+	header = m_mesh_cache.getHeader();
+	elements = m_mesh_cache.getElements();
+	edges = m_mesh_cache.getEdges();
+	geometry = m_mesh_cache.getGeometry();
+	row_ptr = m_mesh_cache.getRowPtr();
+	col_ids = m_mesh_cache.getColIds();
+
+	if (check_source && (header->source_size != m_file.getSize() ||
+		header->source_hash != MeshCache::getSourceHash(m_file.getData(), m_file.getSize()))) {
+		m_mesh_cache.close();
+		return false;
+	}
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT * header->number_of_elements; ++i)
+		if (elements[i] >= header->number_of_nodes) {
+			m_mesh_cache.close();
+			return false;
+		}
+
+	for (unsigned int i = 0; i < header->number_of_edges; ++i)
+		for (unsigned int j = 1; j <= NODES_PER_EDGE; ++j)
+			if (edges[(NODES_PER_EDGE + 1) * i + j] >= header->number_of_nodes) {
+				m_mesh_cache.close();
+				return false;
+			}
+
+	// the pattern is indexed by the assembly without further checks, a damaged one makes the cache stale
+	if (row_ptr != nullptr) {
+		is_pattern_valid = row_ptr[0] == 0 && row_ptr[header->number_of_nodes] == static_cast<int64_t>(header->pattern_size);
+		for (unsigned int i = 0; is_pattern_valid && i < header->number_of_nodes; ++i)
+			is_pattern_valid = row_ptr[i] <= row_ptr[i + 1];
+		for (unsigned int k = 0; is_pattern_valid && k < header->pattern_size; ++k)
+			is_pattern_valid = col_ids[k] >= 0 && static_cast<uint32_t>(col_ids[k]) < header->number_of_nodes;
+
+		if (!is_pattern_valid) {
+			m_mesh_cache.close();
+			return false;
+		}
+	}
+
+	cout << "Loading mesh from cache file " << file_path << "..." << endl << endl;
+
+	m_coords.resize(header->number_of_nodes);
+	memcpy(m_coords.data(), m_mesh_cache.getCoords(), sizeof(double) * COORDS_PER_NODE * header->number_of_nodes);
+	m_max_coord = header->max_coord;
+
+	m_elements.reserve(header->number_of_elements);
+	for (unsigned int i = 0; i < header->number_of_elements; ++i) {
+		for (unsigned int j = 0; j < NODES_PER_ELEMENT; ++j)
+			element_indices[j] = elements[NODES_PER_ELEMENT * i + j];
+		addElement(&element_indices, geometry == nullptr ? nullptr : geometry + ELEMENT_GEOMETRY_SIZE * i);
+	}
+
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+		m_object_center.at(i) = header->object_center[i];
+
+	m_boundary_edges.reserve(header->number_of_edges);
+	m_boundary_edges_hash_table.reserve(header->number_of_edges);
+	for (unsigned int i = 0; i < header->number_of_edges; ++i) {
+		for (unsigned int j = 0; j < NODES_PER_EDGE; ++j)
+			edge_indices[j] = edges[(NODES_PER_EDGE + 1) * i + j + 1];
+		addBoundaryEdge(edges[(NODES_PER_EDGE + 1) * i], &edge_indices);
+	}
+
+	return true;
+}
+
+bool DataLoader::saveMeshCache() const {
+	ProfilerScope scope(m_profiler, "write mesh cache");
+	MeshCacheHeader header;
+	CsrMatrix pattern;
+	vector<uint32_t> elements(NODES_PER_ELEMENT * m_elements.size());
+	vector<uint32_t> edges((NODES_PER_EDGE + 1) * m_boundary_edges.size());
+	vector<double> geometry(ELEMENT_GEOMETRY_SIZE * m_elements.size());
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	const array<unsigned int, NODES_PER_EDGE>* current_edge_nodes_id;
+
+	for (unsigned int i = 0; i < m_elements.size(); ++i) {
+		current_elem_nodes_id = m_elements.at(i).getNodesId();
+		for (unsigned int j = 0; j < NODES_PER_ELEMENT; ++j)
+			elements[NODES_PER_ELEMENT * i + j] = current_elem_nodes_id->at(j);
+		m_elements.at(i).getGeometry(&geometry[ELEMENT_GEOMETRY_SIZE * i]);
+	}
+
+	for (unsigned int i = 0; i < m_boundary_edges.size(); ++i) {
+		current_edge_nodes_id = m_boundary_edges.at(i).getRightIdsOrder();
+		edges[(NODES_PER_EDGE + 1) * i] = m_boundary_edges.at(i).getSurfaceId();
+		for (unsigned int j = 0; j < NODES_PER_EDGE; ++j)
+			edges[(NODES_PER_EDGE + 1) * i + j + 1] = current_edge_nodes_id->at(j);
+	}
+
+	pattern.initPattern(this);
+
+	memset(&header, 0, sizeof(MeshCacheHeader));
+	header.source_size = m_file.getSize();
+	header.source_hash = MeshCache::getSourceHash(m_file.getData(), m_file.getSize());
+	header.number_of_nodes = m_coords.size();
+	header.number_of_elements = m_elements.size();
+	header.number_of_edges = m_boundary_edges.size();
+	header.pattern_size = pattern.getNonZeroCount();
+	header.max_coord = m_max_coord;
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+		header.object_center[i] = m_object_center.at(i);
+
+	return MeshCache::write(m_cache_file_path, &header, m_coords.data()->data(), elements.data(), edges.data(), geometry.data(),
+		pattern.getRowPtr()->data(), pattern.getColIds()->data());
+}
+
+bool DataLoader::initSufaces() {
+	ProfilerScope scope(m_profiler, "boundary conditions");
+	unsigned int  current_node_id, condition_type, number_of_surfaces;
+	double temperature, heat_flow, exchange_coeff;
+	array<unsigned int, NODES_PER_EDGE> nodes_id;
+	array<double, COORDS_PER_NODE> node_coord;
+	Condition* condition = nullptr;
+
+	number_of_surfaces = m_node_examples.size();
+
+	m_surfaces.resize(number_of_surfaces);
+
+	for (unsigned int i = 0; i < number_of_surfaces; ++i) {
+		if (m_config != nullptr) {
+			if (!initSurfaceFromConfig(i, &condition))
+				return false;
+
+			m_surfaces.at(i) = Surface(i, condition);
+			continue;
+		}
+
+		clearScreen();
+		cout << "Input conditions at surface " << i + 1 << endl << "Three nodes that beint to this surface:" << endl << endl;
+		nodes_id = m_node_examples.at(i);
+		for (unsigned int j = 0; j < NODES_PER_EDGE; ++j) {
+			current_node_id = nodes_id.at(j);
+			node_coord = m_coords.at(current_node_id);
+			cout << nodes_id.at(j) << " : " << node_coord.at(0) << ", " << node_coord.at(1) << ", " << node_coord.at(2) << ";" << endl;
+		}
+
+		cout << endl << "Input type of the condition:" << endl << "1 = constant temperature" << endl << "2 = no heat exchange"
+			<< endl << "3 = heat flow" << endl << "4 = environment heat exchange" << endl << endl;
+		cin >> condition_type;
+
+		switch (condition_type)
+		{
+		case 1: {
+			cout << endl << "Input the temperature: ";
+			cin >> temperature;
+			condition = static_cast<Condition*>(new ConstantTempCondition(temperature));
+			Surface surface(i, condition);
+			m_surfaces.at(i) = surface;
+		}
+			  break;
+
+		case 2: {
+			condition = static_cast<Condition*>(new NoHeatExchangeCondition());
+			Surface surface(i, condition);
+			m_surfaces.at(i) = surface;
+		}
+			  break;
+
+		case 3: {
+			cout << endl << "Input the flow value: ";
+			cin >> heat_flow;
+			condition = static_cast<Condition*>(new HeatFlowCondition(heat_flow));
+			Surface surface(i, condition);
+			m_surfaces.at(i) = surface;
+		}
+			  break;
+
+		case 4: {
+			cout << endl << "Input the environment temperature: ";
+			cin >> temperature;
+			cout << endl << "Input the heat exchange coefficient: ";
+			cin >> exchange_coeff;
+			condition = static_cast<Condition*>(new EnvironmentHeatExchangeCondition(temperature, exchange_coeff));
+			Surface surface(i, condition);
+			m_surfaces.at(i) = surface;
+		}
+			  break;
+
+		default:
+			return false;
+		}
+	}
+
+	clearScreen();
+
+	m_node_examples.clear();
+
+	return true;
+}
+
+// A condition type is given by its name or by its number
+ConditionType DataLoader::getConditionType(const string& type) {
+	if (type == "constant_temperature" || type == "1")
+		return CONSTANT_TEMPERATURE;
+
+	if (type == "no_heat_exchange" || type == "2")
+		return NO_HEAT_EXCHANGE;
+
+	if (type == "heat_flow" || type == "3")
+		return HEAT_FLOW;
+
+	if (type == "environment_heat_exchange" || type == "4")
+		return ENVIRONMENT_HEAT_EXCHANGE;
+
+	return NULL_CONDITION;
+}
+
+bool DataLoader::initSurfaceFromConfig(unsigned int id, Condition** condition) const {
+	string section = "surface " + to_string(id + 1);
+	string type;
+	ConditionType condition_type;
+	double temperature, heat_flow, exchange_coeff;
+
+	if (!m_config->hasSection(section)) {
+		cout << "Config file has no section [" << section << "]" << endl;
+		return false;
+	}
+
+	type = m_config->getString(section, "type", "");
+	condition_type = getConditionType(type);
+
+	if (condition_type == CONSTANT_TEMPERATURE) {
+		if (!m_config->getDouble(section, "temperature", &temperature)) {
+			cout << "Section [" << section << "] needs a temperature value" << endl;
+			return false;
+		}
+		*condition = static_cast<Condition*>(new ConstantTempCondition(temperature));
+		return true;
+	}
+
+	if (condition_type == NO_HEAT_EXCHANGE) {
+		*condition = static_cast<Condition*>(new NoHeatExchangeCondition());
+		return true;
+	}
+
+	if (condition_type == HEAT_FLOW) {
+		if (!m_config->getDouble(section, "flow", &heat_flow)) {
+			cout << "Section [" << section << "] needs a flow value" << endl;
+			return false;
+		}
+		*condition = static_cast<Condition*>(new HeatFlowCondition(heat_flow));
+		return true;
+	}
+
+	if (condition_type == ENVIRONMENT_HEAT_EXCHANGE) {
+		if (!m_config->getDouble(section, "temperature", &temperature) || !m_config->getDouble(section, "exchange_coeff", &exchange_coeff)) {
+			cout << "Section [" << section << "] needs temperature and exchange_coeff values" << endl;
+			return false;
+		}
+		*condition = static_cast<Condition*>(new EnvironmentHeatExchangeCondition(temperature, exchange_coeff));
+		return true;
+	}
+
+	cout << "Section [" << section << "] has unknown condition type \"" << type << "\"" << endl;
+	return false;
+}
+
+void DataLoader::initBoundaryFaces() {
+	ProfilerScope scope(m_profiler, "boundary faces");
+	unsigned int number_of_elements = m_elements.size();
+	unsigned int face_id, other_face_id, edge_id;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT> local_numeration;
+	array<unsigned int, NODES_PER_EDGE> face_nodes_id;
+	vector<bool> is_interior(EDGES_PER_ELEMENT * number_of_elements, false);
+	FaceHashTable faces;
+	BoundaryFace boundary_face;
+
+	FiniteElement::setupLocalNumeration(&local_numeration);
+	faces.reserve(2 * number_of_elements + m_boundary_edges.size());
+
+	// a face shared by two elements is interior, only faces owned by exactly one element can carry a condition
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = m_elements.at(i).getNodesId();
+
+		for (unsigned int j = 0; j < EDGES_PER_ELEMENT; ++j) {
+			for (unsigned int k = 0; k < NODES_PER_EDGE; ++k)
+				face_nodes_id[k] = current_elem_nodes_id->at(local_numeration[j][k]);
+
+			face_id = EDGES_PER_ELEMENT * i + j;
+			if (!faces.insert(&face_nodes_id, face_id)) {
+				faces.find(&face_nodes_id, &other_face_id);
+				is_interior[face_id] = true;
+				is_interior[other_face_id] = true;
+			}
+		}
+	}
+
+	m_boundary_faces.clear();
+	m_element_boundary_faces_ptr.assign(number_of_elements + 1, 0);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = m_elements.at(i).getNodesId();
+
+		for (unsigned int j = 0; j < EDGES_PER_ELEMENT; ++j) {
+			if (is_interior[EDGES_PER_ELEMENT * i + j])
+				continue;
+
+			for (unsigned int k = 0; k < NODES_PER_EDGE; ++k)
+				face_nodes_id[k] = current_elem_nodes_id->at(local_numeration[j][k]);
+
+			if (!m_boundary_edges_hash_table.find(&face_nodes_id, &edge_id))
+				continue;
+
+			boundary_face.element_id = i;
+			boundary_face.local_face_id = j;
+			boundary_face.edge_id = edge_id;
+			m_boundary_faces.push_back(boundary_face);
+		}
+
+		m_element_boundary_faces_ptr[i + 1] = m_boundary_faces.size();
+	}
+
+	if (m_boundary_faces.size() != m_boundary_edges_hash_table.getSize())
+		cout << m_boundary_edges_hash_table.getSize() - m_boundary_faces.size()
+			<< " boundary edges of the file are not faces of exactly one element and are ignored" << endl << endl;
+
+	// after renumbering the faces follow the new element order, the order of the mesh file is kept aside
+	m_boundary_faces_mesh_order.clear();
+	if (m_element_mesh_ids.empty())
+		return;
+
+	m_boundary_faces_mesh_order.resize(m_boundary_faces.size());
+	for (unsigned int i = 0; i < m_boundary_faces.size(); ++i)
+		m_boundary_faces_mesh_order[i] = i;
+
+	sort(m_boundary_faces_mesh_order.begin(), m_boundary_faces_mesh_order.end(), [this](unsigned int first, unsigned int second) {
+		const BoundaryFace* first_face = &m_boundary_faces[first];
+		const BoundaryFace* second_face = &m_boundary_faces[second];
+
+		if (m_element_mesh_ids[first_face->element_id] != m_element_mesh_ids[second_face->element_id])
+			return m_element_mesh_ids[first_face->element_id] < m_element_mesh_ids[second_face->element_id];
+		return first_face->local_face_id < second_face->local_face_id;
+	});
+}
+
+// Load cases are read from [case N surface M] sections. They may change only the values that go to the
+// global vector (temperatures and flows), so every case shares the global matrix of the [surface M] conditions.
+// A missing section or key keeps the value of the base condition
+bool DataLoader::initLoadCases() {
+	unsigned int number_of_cases;
+	string section;
+	Condition* condition;
+
+	if (m_config == nullptr || !m_config->hasValue("", "load_cases"))
+		return true;
+
+	if (!m_config->getUnsigned("", "load_cases", &number_of_cases)) {
+		cout << "Incorrect load_cases in the config file" << endl;
+		return false;
+	}
+
+	m_load_cases.resize(number_of_cases);
+
+	for (unsigned int i = 0; i < number_of_cases; ++i)
+		for (unsigned int j = 0; j < m_surfaces.size(); ++j) {
+			section = "case " + to_string(i + 1) + " surface " + to_string(j + 1);
+			if (!initLoadCaseCondition(section, "surface " + to_string(j + 1), m_surfaces.at(j).getCondition(), &condition))
+				return false;
+
+			m_load_cases.at(i).push_back(condition);
+		}
+
+	return true;
+}
+
+bool DataLoader::initLoadCaseCondition(const string& section, const string& base_section, const Condition* base_condition,
+	Condition** condition) const {
+	string type = m_config->getString(section, "type", m_config->getString(base_section, "type", ""));
+	double temperature, heat_flow, exchange_coeff;
+
+	if (getConditionType(type) != base_condition->getType()) {
+		cout << "Section [" << section << "] can't change the condition type" << endl;
+		return false;
+	}
+
+	switch (base_condition->getType()) {
+	case CONSTANT_TEMPERATURE:
+		temperature = static_cast<const ConstantTempCondition*>(base_condition)->getTemperature();
+		if (m_config->hasValue(section, "temperature") && !m_config->getDouble(section, "temperature", &temperature)) {
+			cout << "Section [" << section << "] has incorrect temperature value" << endl;
+			return false;
+		}
+		*condition = static_cast<Condition*>(new ConstantTempCondition(temperature));
+		return true;
+
+	case NO_HEAT_EXCHANGE:
+		*condition = static_cast<Condition*>(new NoHeatExchangeCondition());
+		return true;
+
+	case HEAT_FLOW:
+		heat_flow = static_cast<const HeatFlowCondition*>(base_condition)->getFlow();
+		if (m_config->hasValue(section, "flow") && !m_config->getDouble(section, "flow", &heat_flow)) {
+			cout << "Section [" << section << "] has incorrect flow value" << endl;
+			return false;
+		}
+		*condition = static_cast<Condition*>(new HeatFlowCondition(heat_flow));
+		return true;
+
+	case ENVIRONMENT_HEAT_EXCHANGE:
+		temperature = static_cast<const EnvironmentHeatExchangeCondition*>(base_condition)->getEnvironmentTemp();
+		exchange_coeff = static_cast<const EnvironmentHeatExchangeCondition*>(base_condition)->getEchangeCoeff();
+		if (m_config->hasValue(section, "temperature") && !m_config->getDouble(section, "temperature", &temperature)) {
+			cout << "Section [" << section << "] has incorrect temperature value" << endl;
+			return false;
+		}
+		if (m_config->hasValue(section, "exchange_coeff")) {
+			cout << "Section [" << section << "] can't change exchange_coeff, it is a part of the global matrix" << endl;
+			return false;
+		}
+		*condition = static_cast<Condition*>(new EnvironmentHeatExchangeCondition(temperature, exchange_coeff));
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+void DataLoader::deleteLoadCases() {
+	for (unsigned int i = 0; i < m_load_cases.size(); ++i)
+		for (unsigned int j = 0; j < m_load_cases.at(i).size(); ++j)
+			delete m_load_cases.at(i).at(j);
+
+	m_load_cases.clear();
+}
+
+DataLoader::DataLoader(const string& file_path) : m_file_path(file_path), m_config(nullptr), m_profiler(nullptr), m_cursor(nullptr), m_file_end(nullptr), m_max_coord(0), m_heat_conduction_coeff(DBL_MIN), m_geometry_type(JACOBIAN_GEOMETRY) {
+	m_object_center.fill(0);
+	m_file.open(file_path);
+}
+
+DataLoader::~DataLoader() {
+	for (unsigned int i = 0; i < m_surfaces.size(); ++i)
+		m_surfaces.at(i).deleteCondition();
+
+	deleteLoadCases();
+}
+
+bool DataLoader::loadTextFile() {
+	vector<array<unsigned int, NODES_PER_ELEMENT>> elements_nodes_id;
+
+	m_cursor = m_file.getData();
+	m_file_end = m_cursor + m_file.getSize();
+
+	cout << "Loading nodes... " << endl << endl;
+	if (!initCoords()) {
+		cout << "Incorrect nodes section in the file!" << endl;
+		return false;
+	}
+
+	cout << "Loading elements... " << endl << endl;
+	if (!initElements(&elements_nodes_id)) {
+		cout << "Incorrect elements section in the file!" << endl;
+		return false;
+	}
+
+	initGeometry(&elements_nodes_id);
+
+	cout << "Loading boundary edges... " << endl << endl;
+	if (!initEdges()) {
+		cout << "Incorrect boundary edges section in the file!" << endl;
+		return false;
+	}
+
+	m_cursor = nullptr;
+	m_file_end = nullptr;
+
+	return true;
+}
+
+void DataLoader::setMeshCachePath(const string& file_path) {
+	m_cache_file_path = file_path;
+}
+
+void DataLoader::setConfig(const ConfigFile* config) {
+	m_config = config;
+}
+
+void DataLoader::setProfiler(Profiler* profiler) {
+	m_profiler = profiler;
+}
+
+void DataLoader::setGeometryType(ElementGeometryType geometry_type) {
+	m_geometry_type = geometry_type;
+}
+
+bool DataLoader::loadData()
+{
+	if (!m_file.isOpen()) {
+		cout << "Can't open the file!" << endl;
+		return false;
+	}
+
+	if (MeshCache::isMeshCache(m_file.getData(), m_file.getSize())) {
+		if (!loadMeshCache(m_file_path, false)) {
+			cout << "Incorrect mesh cache file!" << endl;
+			return false;
+		}
+	}
+
+	else if (m_cache_file_path.empty() || !loadMeshCache(m_cache_file_path, true)) {
+		if (!loadTextFile())
+			return false;
+
+		if (!m_cache_file_path.empty() && !saveMeshCache())
+			cout << "Can't write mesh cache file " << m_cache_file_path << endl << endl;
+	}
+
+	clearScreen();
+
+	m_file.close();
+
+	if (!initHeatConduction())
+		return false;
+
+	if (!initSufaces()) {
+		cout << "Incorrect condition type!" << endl;
+		return false;
+	}
+
+	if (!initLoadCases())
+		return false;
+
+	initBoundaryFaces();
+
+	cout << "Data loaded: " << getNodeCount() << " nodes, " << getElementCount()
+		<< " elements and " << getSurfaceCount() << " surfaces" << endl << endl;
+
+	cout << "Boundary faces index: " << m_boundary_edges_hash_table.getSize() << " faces, load factor "
+		<< m_boundary_edges_hash_table.getLoadFactor() << ", average probe length "
+		<< m_boundary_edges_hash_table.getAverageProbeLength() << " (" << m_boundary_edges_hash_table.getAverageMissProbeLength()
+		<< " for interior faces), max " << m_boundary_edges_hash_table.getMaxProbeLength() << endl
+		<< m_boundary_faces.size() << " element faces lie on the boundary" << endl << endl;
+
+	return true;
+}
+
+const FiniteElement* DataLoader::getElement(unsigned int  id) const {
+	return &(m_elements.at(id));
+}
+
+const array<double, COORDS_PER_NODE>* DataLoader::getNodeCoord(unsigned int  id) const {
+	return &(m_coords.at(id));
+}
+
+const Edge* DataLoader::getIfBoundary(const array<unsigned int, NODES_PER_EDGE>* indices) const {
+	unsigned int edge_id;
+
+	if (!m_boundary_edges_hash_table.find(indices, &edge_id))
+		return nullptr;
+
+	return &m_boundary_edges[edge_id];
+}
+
+const Surface* DataLoader::getSurface(unsigned int  id) const {
+	return &(m_surfaces.at(id));
+}
+
+unsigned int DataLoader::getLoadCaseCount() const {
+	return m_load_cases.size();
+}
+
+const Condition* DataLoader::getLoadCaseCondition(unsigned int case_id, unsigned int surface_id) const {
+	return m_load_cases.at(case_id).at(surface_id);
+}
+
+const Edge* DataLoader::getBoundaryEdge(unsigned int id) const {
+	return &(m_boundary_edges.at(id));
+}
+
+unsigned int DataLoader::getBoundaryFaceCount() const {
+	return m_boundary_faces.size();
+}
+
+const BoundaryFace* DataLoader::getBoundaryFace(unsigned int id) const {
+	return &(m_boundary_faces.at(id));
+}
+
+// The id of the i-th boundary face in the element order of the mesh file
+unsigned int DataLoader::getMeshOrderBoundaryFaceId(unsigned int i) const {
+	if (m_boundary_faces_mesh_order.empty())
+		return i;
+
+	return m_boundary_faces_mesh_order.at(i);
+}
+
+unsigned int DataLoader::getElementBoundaryFacesBegin(unsigned int element_id) const {
+	return m_element_boundary_faces_ptr.at(element_id);
+}
+
+unsigned int DataLoader::getElementBoundaryFacesEnd(unsigned int element_id) const {
+	return m_element_boundary_faces_ptr.at(element_id + 1);
+}
+
+void DataLoader::setHeatConductionCoeff(double heat_conduction_coeff) {
+	m_heat_conduction_coeff = heat_conduction_coeff;
+}
+
+double DataLoader::getHeatConductionCoeff() const {
+	return m_heat_conduction_coeff;
+}
+
+unsigned int  DataLoader::getNodeCount() const {
+	return m_coords.size();
+}
+
+unsigned int  DataLoader::getElementCount() const {
+	return m_elements.size();
+}
+
+unsigned int  DataLoader::getSurfaceCount() const {
+	return m_surfaces.size();
+}
+
+double DataLoader::getMaxCoord() const {
+	return m_max_coord;
+}
+
+vector<unsigned int > DataLoader::getBoundaryNodes() const
+{
+	vector<unsigned int > result;
+	const array<unsigned int, NODES_PER_EDGE>* current_edge_node_ids;
+
+	for (unsigned int i = 0; i < m_boundary_edges.size(); ++i) {
+		current_edge_node_ids = m_boundary_edges.at(i).getRightIdsOrder();
+		result.push_back(current_edge_node_ids->at(0));
+		result.push_back(current_edge_node_ids->at(1));
+		result.push_back(current_edge_node_ids->at(2));
+	}
+
+	return result;
+}
+
+// Moves the nodes to their new ids and sorts the elements by their smallest new node id, so elements
+// which are close in memory also touch close nodes. The boundary data is rebuilt for the new ids
+void DataLoader::renumberNodes(const vector<unsigned int>* new_ids) {
+	ProfilerScope scope(m_profiler, "renumbering");
+	unsigned int number_of_nodes = m_coords.size();
+	unsigned int number_of_elements = m_elements.size();
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	vector<array<double, COORDS_PER_NODE>> coords(number_of_nodes);
+	vector<FiniteElement> elements;
+	vector<unsigned int> element_order(number_of_elements);
+	vector<unsigned int> element_keys(number_of_elements);
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i)
+		coords.at(new_ids->at(i)) = m_coords.at(i);
+	m_coords.swap(coords);
+
+	if (m_node_new_ids.empty())
+		m_node_new_ids = *new_ids;
+	else
+		for (unsigned int i = 0; i < number_of_nodes; ++i)
+			m_node_new_ids.at(i) = new_ids->at(m_node_new_ids.at(i));
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = m_elements.at(i).getNodesId();
+		element_keys[i] = number_of_nodes;
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			element_keys[i] = min(element_keys[i], new_ids->at(current_elem_nodes_id->at(k)));
+		element_order[i] = i;
+	}
+
+	stable_sort(element_order.begin(), element_order.end(), [&element_keys](unsigned int first, unsigned int second) {
+		return element_keys[first] < element_keys[second];
+	});
+
+	elements.reserve(number_of_elements);
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		elements.push_back(m_elements.at(element_order[i]));
+		elements.back().renumber(i, new_ids);
+	}
+	m_elements.swap(elements);
+
+	// the position of every element in the mesh file, it keeps the precedence of the boundary faces
+	if (!m_element_mesh_ids.empty())
+		for (unsigned int i = 0; i < number_of_elements; ++i)
+			element_order[i] = m_element_mesh_ids.at(element_order[i]);
+	m_element_mesh_ids.swap(element_order);
+
+	m_boundary_edges_hash_table.clear();
+	m_boundary_edges_hash_table.reserve(m_boundary_edges.size());
+	for (unsigned int i = 0; i < m_boundary_edges.size(); ++i) {
+		m_boundary_edges.at(i).renumberNodes(new_ids);
+		m_boundary_edges_hash_table.insert(m_boundary_edges.at(i).getRightIdsOrder(), i);
+	}
+
+	// the pattern of the mesh cache belongs to the old numbering
+	m_mesh_cache.close();
+
+	initBoundaryFaces();
+}
+
+unsigned int DataLoader::getRenumberedNodeId(unsigned int original_id) const {
+	if (m_node_new_ids.empty())
+		return original_id;
+
+	return m_node_new_ids.at(original_id);
+}
+
+bool DataLoader::getCachedPattern(const int** row_ptr, const int** col_ids, unsigned int* size) const {
+	if (!m_mesh_cache.isOpen() || m_mesh_cache.getRowPtr() == nullptr)
+		return false;
+
+	*row_ptr = m_mesh_cache.getRowPtr();
+	*col_ids = m_mesh_cache.getColIds();
+	*size = m_mesh_cache.getHeader()->pattern_size;
+
+	return true;
+}
+
+void DataLoader::deleteSomeDataBeforeSolve() {
+	m_mesh_cache.close();
+	m_elements.clear();
+	m_boundary_edges_hash_table.clear();
+	m_boundary_faces.clear();
+	m_element_boundary_faces_ptr.clear();
+	m_element_mesh_ids.clear();
+	m_boundary_faces_mesh_order.clear();
+	m_surfaces.clear();
+	deleteLoadCases();
+}
+
+const array<double, COORDS_PER_NODE>* DataLoader::getObjectCenter() const {
+	return &m_object_center;
+}
+
+const FaceHashTable* DataLoader::getBoundaryEdgesHashTable() const {
+	return &m_boundary_edges_hash_table;
+}
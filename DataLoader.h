@@ -1,57 +1,117 @@
-#pragma once
-#include <array>
-#include <vector>
-#include <map>
-#include <fstream>
-#include <iostream>
-#include <string>
-#include <algorithm>
-#include <cmath>
-#include "FiniteElement.h"
-#include "Edge.h"
-#include "Surface.h"
-#include "Defines.h"
-
-using namespace std;
-
-class DataLoader
-{
-private:
-	ifstream m_file;
-	vector<array<double, COORDS_PER_NODE>> m_coords;
-	vector<FiniteElement> m_elements;
-	multimap<unsigned int, unsigned int > m_boundary_edges_hash_table;
-	vector<Edge> m_boundary_edges;
-	vector<Surface> m_surfaces;
-	map<unsigned int, array<unsigned int, COORDS_PER_NODE>> m_node_examples;
-	double m_heat_conduction_coeff;
-	double m_max_coord;
-	array<double, COORDS_PER_NODE> m_object_center;
-
-private:
-	void initHeatConduction();
-	void initCoords();
-	void initElements();
-	void initEdges();
-	bool initSufaces();
-
-public:
-	explicit DataLoader(const string& file_path);
-	~DataLoader();
-	bool loadData();
-	const array<double, COORDS_PER_NODE>* getNodeCoord(unsigned int  id) const;
-	const FiniteElement* getElement(unsigned int  id) const;
-	const Edge* getIfBoundary(array<unsigned int, COORDS_PER_NODE>* indices) const;
-	const Surface* getSurface(unsigned int  id) const;
-	double getHeatConductionCoeff() const;
-	unsigned int  getNodeCount() const;
-	unsigned int  getElementCount() const;
-	unsigned int  getSurfaceCount() const;
-	double getMaxCoord() const;
-	vector<unsigned int> getBoundaryNodes() const;
-	void deleteSomeDataBeforeSolve();
-	const array<double, COORDS_PER_NODE> *getObjectCenter() const;
-
-public:
-	static unsigned int  generateKey(array<unsigned int, COORDS_PER_NODE>* indices);
+#pragma once
+#include <array>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <cstdlib>
+#include <charconv>
+#include <cctype>
+#include "FiniteElement.h"
+#include "Edge.h"
+#include "Surface.h"
+#include "MappedFile.h"
+#include "MeshCache.h"
+#include "ConfigFile.h"
+#include "FaceHashTable.h"
+#include "ElementKernels.h"
+#include "Profiler.h"
+#include "Defines.h"
+
+using namespace std;
+
+struct BoundaryFace {
+	unsigned int element_id;
+	unsigned int local_face_id;
+	unsigned int edge_id;
+};
+
+class DataLoader
+{
+private:
+	string m_file_path;
+	string m_cache_file_path;
+	MappedFile m_file;
+	MeshCache m_mesh_cache;
+	const ConfigFile* m_config;
+	Profiler* m_profiler;
+	const char* m_cursor;
+	const char* m_file_end;
+	vector<array<double, COORDS_PER_NODE>> m_coords;
+	vector<FiniteElement> m_elements;
+	FaceHashTable m_boundary_edges_hash_table;
+	vector<Edge> m_boundary_edges;
+	vector<BoundaryFace> m_boundary_faces;
+	vector<unsigned int> m_element_boundary_faces_ptr;
+	vector<unsigned int> m_element_mesh_ids;
+	vector<unsigned int> m_boundary_faces_mesh_order;
+	vector<Surface> m_surfaces;
+	vector<vector<Condition*>> m_load_cases;
+	vector<unsigned int> m_node_new_ids;
+	map<unsigned int, array<unsigned int, COORDS_PER_NODE>> m_node_examples;
+	double m_heat_conduction_coeff;
+	double m_max_coord;
+	ElementGeometryType m_geometry_type;
+	array<double, COORDS_PER_NODE> m_object_center;
+
+private:
+	bool readUnsigned(unsigned int* value);
+	bool readDouble(double* value);
+	void clearScreen() const;
+	bool initHeatConduction();
+	bool initCoords();
+	bool initElements(vector<array<unsigned int, NODES_PER_ELEMENT>>* elements_nodes_id);
+	void initGeometry(const vector<array<unsigned int, NODES_PER_ELEMENT>>* elements_nodes_id);
+	void initBatchedGeometry(const vector<array<unsigned int, NODES_PER_ELEMENT>>* elements_nodes_id);
+	bool initEdges();
+	bool initSufaces();
+	static ConditionType getConditionType(const string& type);
+	bool initSurfaceFromConfig(unsigned int id, Condition** condition) const;
+	void initBoundaryFaces();
+	bool initLoadCases();
+	bool initLoadCaseCondition(const string& section, const string& base_section, const Condition* base_condition, Condition** condition) const;
+	void deleteLoadCases();
+	void addElement(const array<unsigned int, NODES_PER_ELEMENT>* indices, const double* geometry);
+	void addBoundaryEdge(unsigned int surface_id, array<unsigned int, NODES_PER_EDGE>* indices);
+	bool loadTextFile();
+	bool loadMeshCache(const string& file_path, bool check_source);
+	bool saveMeshCache() const;
+
+public:
+	explicit DataLoader(const string& file_path);
+	~DataLoader();
+	void setMeshCachePath(const string& file_path);
+	void setConfig(const ConfigFile* config);
+	void setHeatConductionCoeff(double heat_conduction_coeff);
+	void setProfiler(Profiler* profiler);
+	void setGeometryType(ElementGeometryType geometry_type);
+	bool loadData();
+	void renumberNodes(const vector<unsigned int>* new_ids);
+	const array<double, COORDS_PER_NODE>* getNodeCoord(unsigned int  id) const;
+	const FiniteElement* getElement(unsigned int  id) const;
+	const Edge* getIfBoundary(const array<unsigned int, NODES_PER_EDGE>* indices) const;
+	const Surface* getSurface(unsigned int  id) const;
+	unsigned int getLoadCaseCount() const;
+	const Condition* getLoadCaseCondition(unsigned int case_id, unsigned int surface_id) const;
+	const Edge* getBoundaryEdge(unsigned int id) const;
+	unsigned int getBoundaryFaceCount() const;
+	const BoundaryFace* getBoundaryFace(unsigned int id) const;
+	unsigned int getMeshOrderBoundaryFaceId(unsigned int i) const;
+	unsigned int getElementBoundaryFacesBegin(unsigned int element_id) const;
+	unsigned int getElementBoundaryFacesEnd(unsigned int element_id) const;
+	bool getCachedPattern(const int** row_ptr, const int** col_ids, unsigned int* size) const;
+	double getHeatConductionCoeff() const;
+	unsigned int  getNodeCount() const;
+	unsigned int getRenumberedNodeId(unsigned int original_id) const;
+	unsigned int  getElementCount() const;
+	unsigned int  getSurfaceCount() const;
+	double getMaxCoord() const;
+	vector<unsigned int> getBoundaryNodes() const;
+	void deleteSomeDataBeforeSolve();
+	const array<double, COORDS_PER_NODE> *getObjectCenter() const;
+	const FaceHashTable* getBoundaryEdgesHashTable() const;
 };
\ No newline at end of file
@@ -1,7 +1,30 @@
-#pragma once
-
-#define COORDS_PER_NODE 3
-#define NODES_PER_ELEMENT 4
-#define NODES_PER_EDGE 3
-#define EDGES_PER_ELEMENT 4
-#define COMPONENTS_PER_COLOR 3
\ No newline at end of file
+#pragma once
+
+#define COORDS_PER_NODE 3
+#define NODES_PER_ELEMENT 4
+#define NODES_PER_EDGE 3
+#define EDGES_PER_ELEMENT 4
+#define COMPONENTS_PER_COLOR 3
+#define ELEMENT_GEOMETRY_SIZE 20
+
+#define DEFAULT_PCG_TOLERANCE 1e-10
+#define DEFAULT_PCG_MAX_ITERATIONS 10000
+
+#define DEFAULT_THETA 1.
+#define DEFAULT_PENALTY_FACTOR 1e10
+#define DEFAULT_OUTPUT_INTERVAL 1
+
+#define AMG_STRENGTH_THRESHOLD 0.08
+#define AMG_COARSEST_SIZE 500
+#define AMG_MAX_LEVELS 20
+#define AMG_JACOBI_SWEEPS 2
+#define AMG_CHEBYSHEV_DEGREE 3
+#define AMG_POWER_ITERATIONS 15
+
+#define RADIX_MIN_DIGIT_BITS 8
+#define RADIX_MAX_DIGIT_BITS 11
+
+// replaces the global operator new in profiling builds, build with -DPROFILER_COUNT_ALLOCATIONS=1
+#ifndef PROFILER_COUNT_ALLOCATIONS
+#define PROFILER_COUNT_ALLOCATIONS 0
+#endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "ElementColoring.h"
+
+ElementColoring::ElementColoring() {
+}
+
+void ElementColoring::init(const DataLoader* data_loader) {
+	unsigned int number_of_elements = data_loader->getElementCount();
+	unsigned int number_of_nodes = data_loader->getNodeCount();
+	unsigned int number_of_colors = 0;
+	unsigned int current_node, current_color, neighbour;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	vector<unsigned int> node_elements_ptr(number_of_nodes + 1, 0);
+	vector<unsigned int> node_elements;
+	vector<unsigned int> elements_color(number_of_elements, 0);
+	vector<unsigned int> forbidden_by;
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			++node_elements_ptr.at(current_elem_nodes_id->at(k) + 1);
+	}
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i)
+		node_elements_ptr.at(i + 1) += node_elements_ptr.at(i);
+
+	node_elements.resize(node_elements_ptr.back());
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k) {
+			current_node = current_elem_nodes_id->at(k);
+			node_elements[node_elements_ptr[current_node]++] = i;
+		}
+	}
+
+	for (unsigned int i = number_of_nodes; i > 0; --i)
+		node_elements_ptr[i] = node_elements_ptr[i - 1];
+	node_elements_ptr[0] = 0;
+
+	// greedy coloring in element order: every element takes the smallest color
+	// that is not used by an already colored element sharing a node with it
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k) {
+			current_node = current_elem_nodes_id->at(k);
+			for (unsigned int l = node_elements_ptr[current_node]; l < node_elements_ptr[current_node + 1]; ++l) {
+				neighbour = node_elements[l];
+				if (neighbour >= i)
+					break;
+				forbidden_by[elements_color[neighbour]] = i + 1;
+			}
+		}
+
+		current_color = 0;
+		while (current_color < number_of_colors && forbidden_by[current_color] == i + 1)
+			++current_color;
+
+		if (current_color == number_of_colors) {
+			++number_of_colors;
+			forbidden_by.push_back(0);
+		}
+
+		elements_color[i] = current_color;
+	}
+
+	m_color_ptr.assign(number_of_colors + 1, 0);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i)
+		++m_color_ptr[elements_color[i] + 1];
+
+	for (unsigned int i = 0; i < number_of_colors; ++i)
+		m_color_ptr[i + 1] += m_color_ptr[i];
+
+	m_elements.resize(number_of_elements);
+	forbidden_by.assign(m_color_ptr.begin(), m_color_ptr.end() - 1);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i)
+		m_elements[forbidden_by[elements_color[i]]++] = i;
+}
+
+unsigned int ElementColoring::getColorCount() const {
+	return m_color_ptr.empty() ? 0 : m_color_ptr.size() - 1;
+}
+
+unsigned int ElementColoring::getColorBegin(unsigned int color) const {
+	return m_color_ptr.at(color);
+}
+
+unsigned int ElementColoring::getColorEnd(unsigned int color) const {
+	return m_color_ptr.at(color + 1);
+}
+
+unsigned int ElementColoring::getElement(unsigned int position) const {
+	return m_elements[position];
+}
+
+void ElementColoring::clear() {
+	m_color_ptr.clear();
+	m_elements.clear();
+	m_color_ptr.shrink_to_fit();
+	m_elements.shrink_to_fit();
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "DataLoader.h"
+#include "Defines.h"
+
+using namespace std;
+
+class ElementColoring {
+private:
+	vector<unsigned int> m_color_ptr;
+	vector<unsigned int> m_elements;
+
+public:
+	ElementColoring();
+	void init(const DataLoader* data_loader);
+	unsigned int getColorCount() const;
+	unsigned int getColorBegin(unsigned int color) const;
+	unsigned int getColorEnd(unsigned int color) const;
+	unsigned int getElement(unsigned int position) const;
+	void clear();
+};
@@ -0,0 +1,196 @@
+#include "ElementKernels.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// A few operators over one vector register, the kernels below are written once for all widths
+#if defined(__AVX512F__)
+#define SIMD_DOUBLE_WIDTH 8
+
+struct SimdDouble {
+	__m512d value;
+	SimdDouble() {}
+	SimdDouble(__m512d init_value) : value(init_value) {}
+	explicit SimdDouble(double init_value) : value(_mm512_set1_pd(init_value)) {}
+	static SimdDouble load(const double* source) { return _mm512_loadu_pd(source); }
+	void store(double* destination) const { _mm512_storeu_pd(destination, value); }
+};
+
+static inline SimdDouble operator+(SimdDouble first, SimdDouble second) { return _mm512_add_pd(first.value, second.value); }
+static inline SimdDouble operator-(SimdDouble first, SimdDouble second) { return _mm512_sub_pd(first.value, second.value); }
+static inline SimdDouble operator*(SimdDouble first, SimdDouble second) { return _mm512_mul_pd(first.value, second.value); }
+static inline SimdDouble operator/(SimdDouble first, SimdDouble second) { return _mm512_div_pd(first.value, second.value); }
+
+#elif defined(__AVX2__)
+#define SIMD_DOUBLE_WIDTH 4
+
+struct SimdDouble {
+	__m256d value;
+	SimdDouble() {}
+	SimdDouble(__m256d init_value) : value(init_value) {}
+	explicit SimdDouble(double init_value) : value(_mm256_set1_pd(init_value)) {}
+	static SimdDouble load(const double* source) { return _mm256_loadu_pd(source); }
+	void store(double* destination) const { _mm256_storeu_pd(destination, value); }
+};
+
+static inline SimdDouble operator+(SimdDouble first, SimdDouble second) { return _mm256_add_pd(first.value, second.value); }
+static inline SimdDouble operator-(SimdDouble first, SimdDouble second) { return _mm256_sub_pd(first.value, second.value); }
+static inline SimdDouble operator*(SimdDouble first, SimdDouble second) { return _mm256_mul_pd(first.value, second.value); }
+static inline SimdDouble operator/(SimdDouble first, SimdDouble second) { return _mm256_div_pd(first.value, second.value); }
+
+#else
+#define SIMD_DOUBLE_WIDTH 1
+
+struct SimdDouble {
+	double value;
+	SimdDouble() {}
+	explicit SimdDouble(double init_value) : value(init_value) {}
+	static SimdDouble load(const double* source) { return SimdDouble(*source); }
+	void store(double* destination) const { *destination = value; }
+};
+
+static inline SimdDouble operator+(SimdDouble first, SimdDouble second) { return SimdDouble(first.value + second.value); }
+static inline SimdDouble operator-(SimdDouble first, SimdDouble second) { return SimdDouble(first.value - second.value); }
+static inline SimdDouble operator*(SimdDouble first, SimdDouble second) { return SimdDouble(first.value * second.value); }
+static inline SimdDouble operator/(SimdDouble first, SimdDouble second) { return SimdDouble(first.value / second.value); }
+#endif
+
+static const unsigned int local_matrix_rows[LOCAL_MATRIX_ENTRIES] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 3 };
+static const unsigned int local_matrix_cols[LOCAL_MATRIX_ENTRIES] = { 0, 1, 2, 3, 1, 2, 3, 2, 3, 3 };
+
+const char* ElementKernels::getInstructionSet() {
+#if defined(__AVX512F__)
+	return "AVX-512";
+#elif defined(__AVX2__)
+	return "AVX2";
+#else
+	return "scalar";
+#endif
+}
+
+// With the edges e_k = x_k - x_3 the gradients of the first three shape functions are the rows
+// of the inverse Jacobian: (e_1 x e_2) / det, (e_2 x e_0) / det and (e_0 x e_1) / det
+void ElementKernels::computeGeometry(const ElementBatchCoords* coords, ElementBatchGeometry* geometry) {
+	SimdDouble x[NODES_PER_ELEMENT], y[NODES_PER_ELEMENT], z[NODES_PER_ELEMENT];
+	SimdDouble edge_x[3], edge_y[3], edge_z[3];
+	SimdDouble b[NODES_PER_ELEMENT], c[NODES_PER_ELEMENT], d[NODES_PER_ELEMENT];
+	SimdDouble determinant, inverse;
+	SimdDouble one(1.), six(6.), four((double)NODES_PER_ELEMENT);
+
+	for (unsigned int lane = 0; lane < ELEMENT_BATCH_SIZE; lane += SIMD_DOUBLE_WIDTH) {
+		for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+			x[i] = SimdDouble::load(&coords->x[i][lane]);
+			y[i] = SimdDouble::load(&coords->y[i][lane]);
+			z[i] = SimdDouble::load(&coords->z[i][lane]);
+		}
+
+		for (unsigned int i = 0; i < 3; ++i) {
+			edge_x[i] = x[i] - x[3];
+			edge_y[i] = y[i] - y[3];
+			edge_z[i] = z[i] - z[3];
+		}
+
+		for (unsigned int i = 0; i < 3; ++i) {
+			unsigned int j = (i + 1) % 3;
+			unsigned int k = (i + 2) % 3;
+			b[i] = edge_y[j] * edge_z[k] - edge_z[j] * edge_y[k];
+			c[i] = edge_z[j] * edge_x[k] - edge_x[j] * edge_z[k];
+			d[i] = edge_x[j] * edge_y[k] - edge_y[j] * edge_x[k];
+		}
+
+		determinant = edge_x[0] * b[0] + edge_y[0] * c[0] + edge_z[0] * d[0];
+		inverse = one / determinant;
+
+		for (unsigned int i = 0; i < 3; ++i) {
+			b[i] = b[i] * inverse;
+			c[i] = c[i] * inverse;
+			d[i] = d[i] * inverse;
+		}
+
+		b[3] = SimdDouble(0.) - (b[0] + b[1] + b[2]);
+		c[3] = SimdDouble(0.) - (c[0] + c[1] + c[2]);
+		d[3] = SimdDouble(0.) - (d[0] + d[1] + d[2]);
+
+		// a_i is the value of the shape function at the origin, every function is 1 at its own node
+		for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+			(SimdDouble(0.) - (b[i] * x[3] + c[i] * y[3] + d[i] * z[3])).store(&geometry->a[i][lane]);
+			b[i].store(&geometry->b[i][lane]);
+			c[i].store(&geometry->c[i][lane]);
+			d[i].store(&geometry->d[i][lane]);
+		}
+		(one + SimdDouble::load(&geometry->a[3][lane])).store(&geometry->a[3][lane]);
+
+		(determinant / six).store(&geometry->volume[lane]);
+		((x[0] + x[1] + x[2] + x[3]) / four).store(&geometry->center[0][lane]);
+		((y[0] + y[1] + y[2] + y[3]) / four).store(&geometry->center[1][lane]);
+		((z[0] + z[1] + z[2] + z[3]) / four).store(&geometry->center[2][lane]);
+	}
+}
+
+// The coefficient arrays hold one row of stride values per local node, starting at the first element of the batch
+void ElementKernels::computeLocalMatrices(const double* b_coeffs, const double* c_coeffs, const double* d_coeffs,
+	const double* volumes, unsigned int stride, double heat_conduction_coeff, ElementBatchMatrices* matrices) {
+	SimdDouble b[NODES_PER_ELEMENT], c[NODES_PER_ELEMENT], d[NODES_PER_ELEMENT];
+	SimdDouble coeff;
+	SimdDouble conduction(heat_conduction_coeff);
+	unsigned int i, j;
+
+	for (unsigned int lane = 0; lane < ELEMENT_BATCH_SIZE; lane += SIMD_DOUBLE_WIDTH) {
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k) {
+			b[k] = SimdDouble::load(b_coeffs + k * stride + lane);
+			c[k] = SimdDouble::load(c_coeffs + k * stride + lane);
+			d[k] = SimdDouble::load(d_coeffs + k * stride + lane);
+		}
+
+		coeff = conduction * SimdDouble::load(volumes + lane);
+
+		for (unsigned int k = 0; k < LOCAL_MATRIX_ENTRIES; ++k) {
+			i = local_matrix_rows[k];
+			j = local_matrix_cols[k];
+			((b[i] * b[j] + c[i] * c[j] + d[i] * d[j]) * coeff).store(&matrices->values[k][lane]);
+		}
+	}
+}
+
+// The local stiffness matrix is k * V * G * G^T with the gradients in the rows of G, so its product
+// with x is formed as the gradient of x first and never needs the matrix entries
+void ElementKernels::applyStiffness(const double* b_coeffs, const double* c_coeffs, const double* d_coeffs,
+	const double* volumes, unsigned int stride, double heat_conduction_coeff,
+	const ElementBatchValues* x, ElementBatchValues* result) {
+	SimdDouble b[NODES_PER_ELEMENT], c[NODES_PER_ELEMENT], d[NODES_PER_ELEMENT];
+	SimdDouble local_x, gradient_x, gradient_y, gradient_z;
+	SimdDouble conduction(heat_conduction_coeff);
+
+	for (unsigned int lane = 0; lane < ELEMENT_BATCH_SIZE; lane += SIMD_DOUBLE_WIDTH) {
+		gradient_x = SimdDouble(0.);
+		gradient_y = SimdDouble(0.);
+		gradient_z = SimdDouble(0.);
+
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k) {
+			b[k] = SimdDouble::load(b_coeffs + k * stride + lane);
+			c[k] = SimdDouble::load(c_coeffs + k * stride + lane);
+			d[k] = SimdDouble::load(d_coeffs + k * stride + lane);
+			local_x = SimdDouble::load(&x->values[k][lane]);
+			gradient_x = gradient_x + b[k] * local_x;
+			gradient_y = gradient_y + c[k] * local_x;
+			gradient_z = gradient_z + d[k] * local_x;
+		}
+
+		local_x = conduction * SimdDouble::load(volumes + lane);
+		gradient_x = gradient_x * local_x;
+		gradient_y = gradient_y * local_x;
+		gradient_z = gradient_z * local_x;
+
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			(b[k] * gradient_x + c[k] * gradient_y + d[k] * gradient_z).store(&result->values[k][lane]);
+	}
+}
+
+void ElementKernels::getLocalMatrix(const ElementBatchMatrices* matrices, unsigned int lane,
+	array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix) {
+	for (unsigned int k = 0; k < LOCAL_MATRIX_ENTRIES; ++k) {
+		(*local_matrix)[local_matrix_rows[k]][local_matrix_cols[k]] = matrices->values[k][lane];
+		(*local_matrix)[local_matrix_cols[k]][local_matrix_rows[k]] = matrices->values[k][lane];
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include "Defines.h"
+
+using namespace std;
+
+#define ELEMENT_BATCH_SIZE 8
+#define LOCAL_MATRIX_ENTRIES 10
+
+// Element data of one batch stored by node and lane, so every row is one vector register
+// with AVX-512 and two with AVX2
+struct alignas(64) ElementBatchCoords {
+	double x[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+	double y[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+	double z[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+};
+
+struct alignas(64) ElementBatchGeometry {
+	double a[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+	double b[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+	double c[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+	double d[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+	double volume[ELEMENT_BATCH_SIZE];
+	double center[COORDS_PER_NODE][ELEMENT_BATCH_SIZE];
+};
+
+// Upper triangle of the local stiffness matrices, row by row
+struct alignas(64) ElementBatchMatrices {
+	double values[LOCAL_MATRIX_ENTRIES][ELEMENT_BATCH_SIZE];
+};
+
+// Nodal values of one batch, gathered from or scattered to a global vector
+struct alignas(64) ElementBatchValues {
+	double values[NODES_PER_ELEMENT][ELEMENT_BATCH_SIZE];
+};
+
+// Batched kernels for linear tetrahedra. They use AVX-512 or AVX2 when the compiler targets them
+// (-mavx512f, -mavx2 or -march=native) and plain loops otherwise
+class ElementKernels {
+public:
+	static const char* getInstructionSet();
+	static void computeGeometry(const ElementBatchCoords* coords, ElementBatchGeometry* geometry);
+	static void computeLocalMatrices(const double* b_coeffs, const double* c_coeffs, const double* d_coeffs,
+									 const double* volumes, unsigned int stride, double heat_conduction_coeff,
+									 ElementBatchMatrices* matrices);
+	static void applyStiffness(const double* b_coeffs, const double* c_coeffs, const double* d_coeffs,
+							   const double* volumes, unsigned int stride, double heat_conduction_coeff,
+							   const ElementBatchValues* x, ElementBatchValues* result);
+	static void getLocalMatrix(const ElementBatchMatrices* matrices, unsigned int lane,
+							   array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix);
+};
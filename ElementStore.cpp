@@ -0,0 +1,53 @@
+#include "ElementStore.h"
+
+ElementStore::ElementStore() : m_size(0), m_stride(0) {}
+
+// Without a coloring the elements keep their own order, so position and element id are the same
+void ElementStore::init(const DataLoader* data_loader, const ElementColoring* coloring) {
+	const FiniteElement* current_elem;
+
+	// a batch may start at any position, the zero padding keeps its last lanes inside the arrays
+	m_size = data_loader->getElementCount();
+	m_stride = m_size + ELEMENT_BATCH_SIZE;
+
+	m_b_coeffs.assign(NODES_PER_ELEMENT * m_stride, 0.);
+	m_c_coeffs.assign(NODES_PER_ELEMENT * m_stride, 0.);
+	m_d_coeffs.assign(NODES_PER_ELEMENT * m_stride, 0.);
+	m_volumes.assign(m_stride, 0.);
+
+	for (unsigned int position = 0; position < m_size; ++position) {
+		current_elem = data_loader->getElement(coloring == nullptr ? position : coloring->getElement(position));
+
+		for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+			m_b_coeffs[i * m_stride + position] = current_elem->getCoeffsB()->at(i);
+			m_c_coeffs[i * m_stride + position] = current_elem->getCoeffsC()->at(i);
+			m_d_coeffs[i * m_stride + position] = current_elem->getCoeffsD()->at(i);
+		}
+
+		m_volumes[position] = current_elem->getVolume();
+	}
+}
+
+unsigned long long ElementStore::getMemorySize() const {
+	return (m_b_coeffs.capacity() + m_c_coeffs.capacity() + m_d_coeffs.capacity() + m_volumes.capacity()) * sizeof(double);
+}
+
+void ElementStore::computeLocalMatrices(unsigned int position, double heat_conduction_coeff, ElementBatchMatrices* matrices) const {
+	ElementKernels::computeLocalMatrices(&m_b_coeffs[position], &m_c_coeffs[position], &m_d_coeffs[position],
+		&m_volumes[position], m_stride, heat_conduction_coeff, matrices);
+}
+
+void ElementStore::applyStiffness(unsigned int position, double heat_conduction_coeff,
+	const ElementBatchValues* x, ElementBatchValues* result) const {
+	ElementKernels::applyStiffness(&m_b_coeffs[position], &m_c_coeffs[position], &m_d_coeffs[position],
+		&m_volumes[position], m_stride, heat_conduction_coeff, x, result);
+}
+
+void ElementStore::clear() {
+	m_size = 0;
+	m_stride = 0;
+	m_b_coeffs.clear();
+	m_c_coeffs.clear();
+	m_d_coeffs.clear();
+	m_volumes.clear();
+}
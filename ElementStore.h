@@ -0,0 +1,27 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "DataLoader.h"
+#include "ElementColoring.h"
+#include "ElementKernels.h"
+#include "Defines.h"
+
+using namespace std;
+
+// Shape function gradients and volumes in structure of arrays layout, stored in the order of
+// the element coloring, so a batch of consecutive positions is a plain vector load
+class ElementStore {
+private:
+	unsigned int m_size;
+	unsigned int m_stride;
+	vector<double> m_b_coeffs, m_c_coeffs, m_d_coeffs;
+	vector<double> m_volumes;
+
+public:
+	ElementStore();
+	void init(const DataLoader* data_loader, const ElementColoring* coloring);
+	unsigned long long getMemorySize() const;
+	void computeLocalMatrices(unsigned int position, double heat_conduction_coeff, ElementBatchMatrices* matrices) const;
+	void applyStiffness(unsigned int position, double heat_conduction_coeff, const ElementBatchValues* x, ElementBatchValues* result) const;
+	void clear();
+};
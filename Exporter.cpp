@@ -1,126 +1,236 @@
-#include "Exporter.h"
-
-Exporter::Exporter(const DataLoader* data_loader, const Solver* solver) : m_data_loader(data_loader), m_solver(solver), m_exe_file_path("") {
-}
-
-void Exporter::setExeFilePath(const string& file_path) {
-	m_exe_file_path = file_path;
-	unsigned int  index = m_exe_file_path.find_last_of('\\');
-	m_exe_file_path = m_exe_file_path.substr(0, index);
-
-	index = m_exe_file_path.find("\\");
-	while (index != -1) {
-		m_exe_file_path.at(index) = '/';
-		index = m_exe_file_path.find("\\");
-	}
-}
-
-void Exporter::generateJSFile(const string& file_path) const {
-	unsigned int  number_of_nodes = m_data_loader->getNodeCount();
-	unsigned int  max_coord = m_data_loader->getMaxCoord();
-	double max_temperature = m_solver->getMaxTemperature();
-	double min_temperature = m_solver->getMinTemperature();
-	double temperature_delta = max_temperature - min_temperature;
-	double current_node_temperature;
-	double color_coeff;
-	double red_coeff, green_coeff, blue_coeff;
-	const array<double, COORDS_PER_NODE>* current_node_coord;
-	const array <double, COORDS_PER_NODE>* object_center = m_data_loader->getObjectCenter();
-	vector <unsigned int > boundary_nodes;
-	ofstream js_file;
-	ifstream js_template_1;
-	ifstream js_template_2;
-
-	cout << "Exporting data to html file..." << endl << endl;
-
-	js_template_1.open(m_exe_file_path + "/webgl sources/1.txt", ios::in);
-	js_template_2.open(m_exe_file_path + "/webgl sources/2.txt", ios::in);
-	js_file.open(m_exe_file_path + file_path, ios::out);
-
-	js_file << js_template_1.rdbuf();
-
-	js_file << endl;
-	js_file << "	let number_of_nodes = " << number_of_nodes << ";" << endl;
-	js_file << "	let coord = new Float32Array(number_of_nodes * COORDS_PER_NODE);" << endl;
-	js_file << "	let color = new Float32Array(number_of_nodes * COLOR_COMPONENTS);" << endl << endl;
-
-	for (unsigned int i = 0; i < number_of_nodes; ++i) {
-		current_node_coord = m_data_loader->getNodeCoord(i);
-		current_node_temperature = m_solver->getTemperatureAtNode(i);
-		color_coeff = (current_node_temperature - min_temperature) / temperature_delta;
-
-		red_coeff = 0;
-		blue_coeff = 0;
-		green_coeff = 0;
-
-		if (color_coeff >= 0 && color_coeff <= 0.25) {
-			red_coeff = 0;
-			green_coeff = 4 * color_coeff;
-			blue_coeff = 1;
-		}
-		if (color_coeff > 0.25 && color_coeff <= 0.5) {
-			red_coeff = 0;
-			green_coeff = 1;
-			blue_coeff = 2 - 4 * color_coeff;
-		}
-		if (color_coeff > 0.5 && color_coeff <= 0.75) {
-			red_coeff = 4 * color_coeff - 2;
-			green_coeff = 1;
-			blue_coeff = 0;
-		}
-		if (color_coeff > 0.75 && color_coeff <= 1) {
-			red_coeff = 1;
-			green_coeff = 4 - 4 * color_coeff;
-			blue_coeff = 0;
-		}
-
-		js_file << "	coord[" << i * 3 << "] = " << (current_node_coord->at(0) - object_center->at(0)) / max_coord << ";" << endl;
-		js_file << "	coord[" << i * 3 + 1 << "] = " << (current_node_coord->at(1) - object_center->at(1)) / max_coord << ";" << endl;
-		js_file << "	coord[" << i * 3 + 2 << "] = " << (current_node_coord->at(2) - object_center->at(2)) / max_coord << ";" << endl;
-		js_file << "	color[" << i * 3 << "] = " << red_coeff << ";" << endl;
-		js_file << "	color[" << i * 3 + 1 << "] = " << green_coeff << ";" << endl;
-		js_file << "	color[" << i * 3 + 2 << "] = " << blue_coeff << ";" << endl;
-		js_file << endl;
-	}
-
-	boundary_nodes = m_data_loader->getBoundaryNodes();
-	js_file << "	let indices = new Uint16Array(" << boundary_nodes.size() << ");" << endl << endl;
-
-	for (unsigned int i = 0; i < boundary_nodes.size(); ++i)
-		js_file << "	indices[" << i << "] = " << boundary_nodes.at(i) << ";" << endl;
-
-	js_file << endl;
-
-	js_file << js_template_2.rdbuf();
-
-	js_template_1.close();
-	js_template_2.close();
-	js_file.close();
-
-	cout << "Data exported" << endl << endl;
-}
-
-void Exporter::genetateTxtFile(const string& file_path) const {
-	unsigned int  number_of_nodes = m_data_loader->getNodeCount();
-	double current_node_temperature;
-	double max_temperature = m_solver->getMaxTemperature();
-	double min_temperature = m_solver->getMinTemperature();
-	ofstream txt_file;
-
-	cout << "Exporting data to txt file..." << endl << endl;
-
-	txt_file.open(m_exe_file_path + file_path, ios::out);
-
-	txt_file << max_temperature << endl;
-	txt_file << min_temperature << endl;
-
-	for (unsigned int i = 0; i < number_of_nodes; ++i) {
-		current_node_temperature = m_solver->getTemperatureAtNode(i);
-		txt_file << i << "	" << current_node_temperature;
-		txt_file << endl;
-	}
-
-	txt_file.close();
-
-	cout << "Data exported" << endl << endl;
-}
+#include "Exporter.h"
+
+Exporter::Exporter(const DataLoader* data_loader, const Solver* solver) : m_data_loader(data_loader), m_solver(solver), m_exe_file_path(""), m_output_path("") {
+}
+
+void Exporter::setExeFilePath(const string& file_path) {
+	m_exe_file_path = file_path;
+	size_t index = m_exe_file_path.find_last_of("\\/");
+	if (index == string::npos)
+		m_exe_file_path = ".";
+	else
+		m_exe_file_path = m_exe_file_path.substr(0, index);
+
+	index = m_exe_file_path.find("\\");
+	while (index != -1) {
+		m_exe_file_path.at(index) = '/';
+		index = m_exe_file_path.find("\\");
+	}
+
+	if (m_output_path.empty())
+		m_output_path = m_exe_file_path;
+}
+
+void Exporter::setOutputDirectory(const string& directory_path) {
+	m_output_path = directory_path;
+}
+
+bool Exporter::generateJSFile(const string& file_path) const {
+	unsigned int  number_of_nodes = m_data_loader->getNodeCount();
+	unsigned int  max_coord = m_data_loader->getMaxCoord();
+	double max_temperature = m_solver->getMaxTemperature();
+	double min_temperature = m_solver->getMinTemperature();
+	double temperature_delta = max_temperature - min_temperature;
+	double current_node_temperature;
+	double color_coeff;
+	double red_coeff, green_coeff, blue_coeff;
+	const array<double, COORDS_PER_NODE>* current_node_coord;
+	const array <double, COORDS_PER_NODE>* object_center = m_data_loader->getObjectCenter();
+	vector <unsigned int > boundary_nodes;
+	ofstream js_file;
+	ifstream js_template_1;
+	ifstream js_template_2;
+
+	cout << "Exporting data to html file..." << endl << endl;
+
+	js_template_1.open(m_exe_file_path + "/webgl sources/1.txt", ios::in);
+	js_template_2.open(m_exe_file_path + "/webgl sources/2.txt", ios::in);
+	js_file.open(m_output_path + file_path, ios::out);
+
+	if (!js_template_1.is_open() || !js_template_2.is_open() || !js_file.is_open()) {
+		cout << "Can't export data to html file!" << endl << endl;
+		return false;
+	}
+
+	js_file << js_template_1.rdbuf();
+
+	js_file << endl;
+	js_file << "	let number_of_nodes = " << number_of_nodes << ";" << endl;
+	js_file << "	let coord = new Float32Array(number_of_nodes * COORDS_PER_NODE);" << endl;
+	js_file << "	let color = new Float32Array(number_of_nodes * COLOR_COMPONENTS);" << endl << endl;
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		current_node_coord = m_data_loader->getNodeCoord(i);
+		current_node_temperature = m_solver->getTemperatureAtNode(i);
+		color_coeff = (current_node_temperature - min_temperature) / temperature_delta;
+
+		red_coeff = 0;
+		blue_coeff = 0;
+		green_coeff = 0;
+
+		if (color_coeff >= 0 && color_coeff <= 0.25) {
+			red_coeff = 0;
+			green_coeff = 4 * color_coeff;
+			blue_coeff = 1;
+		}
+		if (color_coeff > 0.25 && color_coeff <= 0.5) {
+			red_coeff = 0;
+			green_coeff = 1;
+			blue_coeff = 2 - 4 * color_coeff;
+		}
+		if (color_coeff > 0.5 && color_coeff <= 0.75) {
+			red_coeff = 4 * color_coeff - 2;
+			green_coeff = 1;
+			blue_coeff = 0;
+		}
+		if (color_coeff > 0.75 && color_coeff <= 1) {
+			red_coeff = 1;
+			green_coeff = 4 - 4 * color_coeff;
+			blue_coeff = 0;
+		}
+
+		js_file << "	coord[" << i * 3 << "] = " << (current_node_coord->at(0) - object_center->at(0)) / max_coord << ";" << endl;
+		js_file << "	coord[" << i * 3 + 1 << "] = " << (current_node_coord->at(1) - object_center->at(1)) / max_coord << ";" << endl;
+		js_file << "	coord[" << i * 3 + 2 << "] = " << (current_node_coord->at(2) - object_center->at(2)) / max_coord << ";" << endl;
+		js_file << "	color[" << i * 3 << "] = " << red_coeff << ";" << endl;
+		js_file << "	color[" << i * 3 + 1 << "] = " << green_coeff << ";" << endl;
+		js_file << "	color[" << i * 3 + 2 << "] = " << blue_coeff << ";" << endl;
+		js_file << endl;
+	}
+
+	boundary_nodes = m_data_loader->getBoundaryNodes();
+	js_file << "	let indices = new Uint16Array(" << boundary_nodes.size() << ");" << endl << endl;
+
+	for (unsigned int i = 0; i < boundary_nodes.size(); ++i)
+		js_file << "	indices[" << i << "] = " << boundary_nodes.at(i) << ";" << endl;
+
+	js_file << endl;
+
+	js_file << js_template_2.rdbuf();
+
+	js_template_1.close();
+	js_template_2.close();
+	js_file.close();
+
+	cout << "Data exported" << endl << endl;
+
+	return true;
+}
+
+bool Exporter::genetateTxtFile(const string& file_path) const {
+	unsigned int  number_of_nodes = m_data_loader->getNodeCount();
+	double current_node_temperature;
+	double max_temperature = m_solver->getMaxTemperature();
+	double min_temperature = m_solver->getMinTemperature();
+	ofstream txt_file;
+
+	cout << "Exporting data to txt file..." << endl << endl;
+
+	txt_file.open(m_output_path + file_path, ios::out);
+
+	if (!txt_file.is_open()) {
+		cout << "Can't export data to txt file!" << endl << endl;
+		return false;
+	}
+
+	txt_file << max_temperature << endl;
+	txt_file << min_temperature << endl;
+
+	// the nodes are written with the ids of the mesh file, also when the solver renumbered them
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		current_node_temperature = m_solver->getTemperatureAtNode(m_data_loader->getRenumberedNodeId(i));
+		txt_file << i << "	" << current_node_temperature;
+		txt_file << endl;
+	}
+
+	txt_file.close();
+
+	cout << "Data exported" << endl << endl;
+
+	return true;
+}
+
+// Every stored time step goes to its own file in the result.txt format, named
+// <stem>_<step>.<ext>, and a <stem>_series.<ext> summary lists time, max, min and mean
+bool Exporter::generateTimeSeriesFiles(const string& file_path) const {
+	unsigned int number_of_states = m_solver->getTimeSeriesSize();
+	size_t index = file_path.find_last_of('.');
+	string stem = index == string::npos ? file_path : file_path.substr(0, index);
+	string extension = index == string::npos ? "" : file_path.substr(index);
+	const Eigen::VectorXd* current_state;
+	ofstream series_file;
+	ofstream txt_file;
+
+	cout << "Exporting time series to txt files..." << endl << endl;
+
+	series_file.open(m_output_path + stem + "_series" + extension, ios::out);
+
+	if (!series_file.is_open()) {
+		cout << "Can't export time series to txt file!" << endl << endl;
+		return false;
+	}
+
+	for (unsigned int i = 0; i < number_of_states; ++i) {
+		current_state = m_solver->getTimeSeriesState(i);
+		txt_file.open(m_output_path + stem + "_" + to_string(i) + extension, ios::out);
+
+		if (!txt_file.is_open()) {
+			cout << "Can't export time series to txt file!" << endl << endl;
+			return false;
+		}
+
+		txt_file << current_state->maxCoeff() << endl;
+		txt_file << current_state->minCoeff() << endl;
+
+		for (unsigned int j = 0; j < current_state->size(); ++j)
+			txt_file << j << "	" << (*current_state)(m_data_loader->getRenumberedNodeId(j)) << endl;
+
+		txt_file.close();
+
+		series_file << i << "	" << m_solver->getTimeSeriesTime(i) << "	" << current_state->maxCoeff() << "	"
+			<< current_state->minCoeff() << "	" << current_state->mean() << endl;
+	}
+
+	series_file.close();
+
+	cout << "Data exported" << endl << endl;
+
+	return true;
+}
+
+// Load case N goes to <stem>_case_N.<ext> in the result.txt format. The result block is stored by
+// rows, so all files are written in one pass over the nodes
+bool Exporter::generateLoadCaseFiles(const string& file_path) const {
+	unsigned int number_of_nodes = m_data_loader->getNodeCount();
+	unsigned int number_of_cases = m_solver->getLoadCaseCount();
+	const LoadCaseBlock* results = m_solver->getLoadCaseResults();
+	size_t index = file_path.find_last_of('.');
+	string stem = index == string::npos ? file_path : file_path.substr(0, index);
+	string extension = index == string::npos ? "" : file_path.substr(index);
+	vector<ofstream> txt_files(number_of_cases);
+
+	cout << "Exporting " << number_of_cases << " load cases to txt files..." << endl << endl;
+
+	for (unsigned int i = 0; i < number_of_cases; ++i) {
+		txt_files.at(i).open(m_output_path + stem + "_case_" + to_string(i + 1) + extension, ios::out);
+
+		if (!txt_files.at(i).is_open()) {
+			cout << "Can't export load cases to txt file!" << endl << endl;
+			return false;
+		}
+
+		txt_files.at(i) << results->col(i + 1).maxCoeff() << endl;
+		txt_files.at(i) << results->col(i + 1).minCoeff() << endl;
+	}
+
+	for (unsigned int j = 0; j < number_of_nodes; ++j)
+		for (unsigned int i = 0; i < number_of_cases; ++i)
+			txt_files.at(i) << j << "	" << (*results)(m_data_loader->getRenumberedNodeId(j), i + 1) << endl;
+
+	for (unsigned int i = 0; i < number_of_cases; ++i)
+		txt_files.at(i).close();
+
+	cout << "Data exported" << endl << endl;
+
+	return true;
+}
@@ -0,0 +1,173 @@
+#include "FaceHashTable.h"
+
+FaceHashTable::FaceHashTable() : m_size(0), m_total_probe_length(0), m_max_probe_length(0) {
+}
+
+void FaceHashTable::makeKey(const array<unsigned int, NODES_PER_EDGE>* indices, uint64_t* low_ids, uint32_t* high_id) {
+	array<unsigned int, NODES_PER_EDGE> sorted_indices = *indices;
+
+	sort(sorted_indices.begin(), sorted_indices.end());
+
+	*low_ids = (static_cast<uint64_t>(sorted_indices[0]) << 32) | sorted_indices[1];
+	*high_id = sorted_indices[2];
+}
+
+uint64_t FaceHashTable::hashKey(uint64_t low_ids, uint32_t high_id) {
+	uint64_t hash = low_ids ^ (static_cast<uint64_t>(high_id) * 0x9e3779b97f4a7c15ull);
+
+	hash ^= hash >> 30;
+	hash *= 0xbf58476d1ce4e5b9ull;
+	hash ^= hash >> 27;
+	hash *= 0x94d049bb133111ebull;
+	hash ^= hash >> 31;
+
+	return hash;
+}
+
+unsigned int FaceHashTable::findSlot(uint64_t low_ids, uint32_t high_id, unsigned int* probe_length) const {
+	unsigned int mask = m_slots.size() - 1;
+	unsigned int position = hashKey(low_ids, high_id) & mask;
+
+	*probe_length = 1;
+
+	while (m_slots[position].value != FACE_HASH_EMPTY_SLOT &&
+		(m_slots[position].low_ids != low_ids || m_slots[position].high_id != high_id)) {
+		position = (position + 1) & mask;
+		++*probe_length;
+	}
+
+	return position;
+}
+
+void FaceHashTable::rehash(unsigned int capacity) {
+	vector<FaceHashSlot> old_slots;
+	FaceHashSlot empty_slot = { 0, 0, FACE_HASH_EMPTY_SLOT };
+	unsigned int position, probe_length;
+
+	old_slots.swap(m_slots);
+	m_slots.assign(capacity, empty_slot);
+	m_total_probe_length = 0;
+	m_max_probe_length = 0;
+
+	for (unsigned int i = 0; i < old_slots.size(); ++i) {
+		if (old_slots[i].value == FACE_HASH_EMPTY_SLOT)
+			continue;
+
+		position = findSlot(old_slots[i].low_ids, old_slots[i].high_id, &probe_length);
+		m_slots[position] = old_slots[i];
+		m_total_probe_length += probe_length;
+		m_max_probe_length = max(m_max_probe_length, probe_length);
+	}
+}
+
+void FaceHashTable::reserve(unsigned int number_of_faces) {
+	unsigned int capacity = 16;
+
+	while (capacity * FACE_HASH_MAX_LOAD_FACTOR < number_of_faces)
+		capacity *= 2;
+
+	if (capacity > m_slots.size())
+		rehash(capacity);
+}
+
+bool FaceHashTable::insert(const array<unsigned int, NODES_PER_EDGE>* indices, unsigned int value) {
+	uint64_t low_ids;
+	uint32_t high_id;
+	unsigned int position, probe_length;
+
+	if (m_slots.empty() || (m_size + 1) > m_slots.size() * FACE_HASH_MAX_LOAD_FACTOR)
+		reserve(m_size + 1);
+
+	makeKey(indices, &low_ids, &high_id);
+	position = findSlot(low_ids, high_id, &probe_length);
+
+	// the first face with these nodes wins, later duplicates are ignored
+	if (m_slots[position].value != FACE_HASH_EMPTY_SLOT)
+		return false;
+
+	m_slots[position].low_ids = low_ids;
+	m_slots[position].high_id = high_id;
+	m_slots[position].value = value;
+	++m_size;
+	m_total_probe_length += probe_length;
+	m_max_probe_length = max(m_max_probe_length, probe_length);
+
+	return true;
+}
+
+bool FaceHashTable::find(const array<unsigned int, NODES_PER_EDGE>* indices, unsigned int* value) const {
+	uint64_t low_ids;
+	uint32_t high_id;
+	unsigned int position, probe_length;
+
+	if (m_size == 0)
+		return false;
+
+	makeKey(indices, &low_ids, &high_id);
+	position = findSlot(low_ids, high_id, &probe_length);
+
+	if (m_slots[position].value == FACE_HASH_EMPTY_SLOT)
+		return false;
+
+	*value = m_slots[position].value;
+
+	return true;
+}
+
+void FaceHashTable::clear() {
+	m_slots.clear();
+	m_slots.shrink_to_fit();
+	m_size = 0;
+	m_total_probe_length = 0;
+	m_max_probe_length = 0;
+}
+
+unsigned int FaceHashTable::getSize() const {
+	return m_size;
+}
+
+unsigned int FaceHashTable::getCapacity() const {
+	return m_slots.size();
+}
+
+double FaceHashTable::getLoadFactor() const {
+	if (m_slots.empty())
+		return 0.;
+
+	return static_cast<double>(m_size) / m_slots.size();
+}
+
+double FaceHashTable::getAverageProbeLength() const {
+	if (m_size == 0)
+		return 0.;
+
+	return static_cast<double>(m_total_probe_length) / m_size;
+}
+
+double FaceHashTable::getAverageMissProbeLength() const {
+	unsigned int mask = m_slots.size() - 1;
+	unsigned long long total_probe_length = 0;
+	unsigned int run_length = 0;
+	unsigned int first_empty = 0;
+
+	if (m_slots.empty())
+		return 0.;
+
+	while (m_slots[first_empty].value != FACE_HASH_EMPTY_SLOT)
+		++first_empty;
+
+	// a miss which starts inside a run of occupied slots walks to its end
+	for (unsigned int i = 1; i <= m_slots.size(); ++i) {
+		if (m_slots[(first_empty - i) & mask].value == FACE_HASH_EMPTY_SLOT)
+			run_length = 0;
+		else
+			++run_length;
+		total_probe_length += run_length + 1;
+	}
+
+	return static_cast<double>(total_probe_length) / m_slots.size();
+}
+
+unsigned int FaceHashTable::getMaxProbeLength() const {
+	return m_max_probe_length;
+}
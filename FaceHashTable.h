@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "Defines.h"
+
+using namespace std;
+
+#define FACE_HASH_EMPTY_SLOT UINT32_MAX
+#define FACE_HASH_MAX_LOAD_FACTOR 0.5
+
+// The key is the sorted triple of node ids: the two smallest ids are packed into
+// 64 bits and the largest one is kept next to them, so equal keys mean equal faces
+struct FaceHashSlot {
+	uint64_t low_ids;
+	uint32_t high_id;
+	uint32_t value;
+};
+
+// Open addressing hash table with linear probing which maps a boundary face to
+// its index in the boundary edges array. Stored keys never move until the next
+// rehash, so the probe length of every successful lookup is known at insertion
+// and lookups stay free of shared state
+class FaceHashTable {
+private:
+	vector<FaceHashSlot> m_slots;
+	unsigned int m_size;
+	unsigned long long m_total_probe_length;
+	unsigned int m_max_probe_length;
+
+private:
+	static void makeKey(const array<unsigned int, NODES_PER_EDGE>* indices, uint64_t* low_ids, uint32_t* high_id);
+	static uint64_t hashKey(uint64_t low_ids, uint32_t high_id);
+	unsigned int findSlot(uint64_t low_ids, uint32_t high_id, unsigned int* probe_length) const;
+	void rehash(unsigned int capacity);
+
+public:
+	FaceHashTable();
+	void reserve(unsigned int number_of_faces);
+	bool insert(const array<unsigned int, NODES_PER_EDGE>* indices, unsigned int value);
+	bool find(const array<unsigned int, NODES_PER_EDGE>* indices, unsigned int* value) const;
+	void clear();
+	unsigned int getSize() const;
+	unsigned int getCapacity() const;
+	double getLoadFactor() const;
+	double getAverageProbeLength() const;
+	double getAverageMissProbeLength() const;
+	unsigned int getMaxProbeLength() const;
+};
@@ -1,187 +1,283 @@
-#include "FiniteElement.h"
-
-double FiniteElement::calcDeleterminantPtr(double* matrix[3][3]) const {
-	return
-		*matrix[0][0] * *matrix[1][1] * *matrix[2][2] + *matrix[0][1] * *matrix[1][2] * *matrix[2][0] +
-		*matrix[0][2] * *matrix[1][0] * *matrix[2][1] - *matrix[0][2] * *matrix[1][1] * *matrix[2][0] -
-		*matrix[0][1] * *matrix[1][0] * *matrix[2][2] - *matrix[0][0] * *matrix[1][2] * *matrix[2][1];
-}
-
-void FiniteElement::initCenter(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
-	double x_accumulator = 0;
-	double y_accumulator = 0;
-	double z_accumulator = 0;
-	const array<double, COORDS_PER_NODE>* current_node;
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
-		current_node = &(coord_array->at(m_nodes_id.at(i)));
-		x_accumulator += current_node->at(0);
-		y_accumulator += current_node->at(1);
-		z_accumulator += current_node->at(2);
-	}
-
-	m_center.at(0) = x_accumulator / NODES_PER_ELEMENT;
-	m_center.at(1) = y_accumulator / NODES_PER_ELEMENT;
-	m_center.at(2) = z_accumulator / NODES_PER_ELEMENT;
-}
-
-void FiniteElement::initVolume(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
-	double matrix[3][3];
-	const array<double, COORDS_PER_NODE>* basic_node;
-	const array<double, COORDS_PER_NODE>* current_node;
-
-	basic_node = &(coord_array->at(m_nodes_id.at(3)));
-	for (unsigned int j = 0; j < 3; ++j) {
-		current_node = &(coord_array->at(m_nodes_id.at(j)));
-		for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
-			matrix[i][j] = current_node->at(i) - basic_node->at(i);
-	}
-
-	m_volume = calcDeterminant(matrix);
-	m_volume /= 6.;
-}
-
-void FiniteElement::initShapeFunctions(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
-	double* matrix[3][3];
-	double x_coord[NODES_PER_ELEMENT];
-	double y_coord[NODES_PER_ELEMENT];
-	double z_coord[NODES_PER_ELEMENT];
-	double delta, delta_1, delta_2, delta_3, delta_4;
-	double one = 1.;
-	unsigned int  j, k, l, current_index;
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
-		current_index = m_nodes_id[i];
-		x_coord[i] = coord_array->at(current_index).at(0);
-		y_coord[i] = coord_array->at(current_index).at(1);
-		z_coord[i] = coord_array->at(current_index).at(2);
-	}
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
-		j = (i + 1) % NODES_PER_ELEMENT;
-		k = (i + 2) % NODES_PER_ELEMENT;
-		l = (i + 3) % NODES_PER_ELEMENT;
-
-		delta = 0;
-
-		matrix[0][0] = &x_coord[j];
-		matrix[0][1] = &y_coord[j];
-		matrix[0][2] = &z_coord[j];
-
-		matrix[1][0] = &x_coord[k];
-		matrix[1][1] = &y_coord[k];
-		matrix[1][2] = &z_coord[k];
-
-		matrix[2][0] = &x_coord[l];
-		matrix[2][1] = &y_coord[l];
-		matrix[2][2] = &z_coord[l];
-
-		delta += calcDeleterminantPtr(matrix);
-
-		matrix[0][0] = &x_coord[i];
-		matrix[0][1] = &y_coord[i];
-		matrix[0][2] = &z_coord[i];
-
-		delta -= calcDeleterminantPtr(matrix);
-
-		matrix[1][0] = &x_coord[j];
-		matrix[1][1] = &y_coord[j];
-		matrix[1][2] = &z_coord[j];
-
-		delta += calcDeleterminantPtr(matrix);
-
-		matrix[2][0] = &x_coord[k];
-		matrix[2][1] = &y_coord[k];
-		matrix[2][2] = &z_coord[k];
-
-		delta -= calcDeleterminantPtr(matrix);
-
-		matrix[0][0] = &x_coord[j];
-		matrix[0][1] = &y_coord[j];
-		matrix[0][2] = &z_coord[j];
-
-		matrix[1][0] = &x_coord[k];
-		matrix[1][1] = &y_coord[k];
-		matrix[1][2] = &z_coord[k];
-
-		matrix[2][0] = &x_coord[l];
-		matrix[2][1] = &y_coord[l];
-		matrix[2][2] = &z_coord[l];
-
-		delta_1 = calcDeleterminantPtr(matrix);
-
-		matrix[0][0] = &one;
-		matrix[1][0] = &one;
-		matrix[2][0] = &one;
-
-		delta_2 = -calcDeleterminantPtr(matrix);
-
-		matrix[0][1] = &x_coord[j];
-		matrix[1][1] = &x_coord[k];
-		matrix[2][1] = &x_coord[l];
-
-		delta_3 = calcDeleterminantPtr(matrix);
-
-		matrix[0][2] = &y_coord[j];
-		matrix[1][2] = &y_coord[k];
-		matrix[2][2] = &y_coord[l];
-
-		delta_4 = -calcDeleterminantPtr(matrix);
-
-		m_a_coeff.at(i) = delta_1 / delta;
-		m_b_coeff.at(i) = delta_2 / delta;
-		m_c_coeff.at(i) = delta_3 / delta;
-		m_d_coeff.at(i) = delta_4 / delta;
-	}
-}
-
-FiniteElement::FiniteElement(unsigned int  id, const array<unsigned int, NODES_PER_ELEMENT>* nodes_id,
-	const vector<array<double, COORDS_PER_NODE>>* coord_array) :
-	m_id(id) {
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
-		m_nodes_id.at(i) = nodes_id->at(i);
-
-	initCenter(coord_array);
-	initVolume(coord_array);
-	initShapeFunctions(coord_array);
-}
-
-unsigned int  FiniteElement::getID() const {
-	return m_id;
-}
-
-const array<unsigned int, NODES_PER_ELEMENT>* FiniteElement::getNodesId() const {
-	return &m_nodes_id;
-}
-
-const array<double, COORDS_PER_NODE>* FiniteElement::getCenter() const {
-	return &m_center;
-}
-
-double FiniteElement::getVolume() const {
-	return m_volume;
-}
-
-const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsA() const {
-	return &m_a_coeff;
-}
-
-const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsB() const {
-	return &m_b_coeff;
-}
-
-const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsC() const {
-	return &m_c_coeff;
-}
-
-const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsD() const {
-	return &m_d_coeff;
-}
-
-double FiniteElement::calcDeterminant(const double matrix[][3]) const {
-	return
-		matrix[0][0] * matrix[1][1] * matrix[2][2] + matrix[0][1] * matrix[1][2] * matrix[2][0] +
-		matrix[0][2] * matrix[1][0] * matrix[2][1] - matrix[0][2] * matrix[1][1] * matrix[2][0] -
-		matrix[0][1] * matrix[1][0] * matrix[2][2] - matrix[0][0] * matrix[1][2] * matrix[2][1];
+#include "FiniteElement.h"
+
+double FiniteElement::calcDeleterminantPtr(double* matrix[3][3]) const {
+	return
+		*matrix[0][0] * *matrix[1][1] * *matrix[2][2] + *matrix[0][1] * *matrix[1][2] * *matrix[2][0] +
+		*matrix[0][2] * *matrix[1][0] * *matrix[2][1] - *matrix[0][2] * *matrix[1][1] * *matrix[2][0] -
+		*matrix[0][1] * *matrix[1][0] * *matrix[2][2] - *matrix[0][0] * *matrix[1][2] * *matrix[2][1];
+}
+
+void FiniteElement::initCenter(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
+	double x_accumulator = 0;
+	double y_accumulator = 0;
+	double z_accumulator = 0;
+	const array<double, COORDS_PER_NODE>* current_node;
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+		current_node = &(coord_array->at(m_nodes_id.at(i)));
+		x_accumulator += current_node->at(0);
+		y_accumulator += current_node->at(1);
+		z_accumulator += current_node->at(2);
+	}
+
+	m_center.at(0) = x_accumulator / NODES_PER_ELEMENT;
+	m_center.at(1) = y_accumulator / NODES_PER_ELEMENT;
+	m_center.at(2) = z_accumulator / NODES_PER_ELEMENT;
+}
+
+void FiniteElement::initVolume(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
+	double matrix[3][3];
+	const array<double, COORDS_PER_NODE>* basic_node;
+	const array<double, COORDS_PER_NODE>* current_node;
+
+	basic_node = &(coord_array->at(m_nodes_id.at(3)));
+	for (unsigned int j = 0; j < 3; ++j) {
+		current_node = &(coord_array->at(m_nodes_id.at(j)));
+		for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+			matrix[i][j] = current_node->at(i) - basic_node->at(i);
+	}
+
+	m_volume = calcDeterminant(matrix);
+	m_volume /= 6.;
+}
+
+void FiniteElement::initShapeFunctions(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
+	double* matrix[3][3];
+	double x_coord[NODES_PER_ELEMENT];
+	double y_coord[NODES_PER_ELEMENT];
+	double z_coord[NODES_PER_ELEMENT];
+	double delta, delta_1, delta_2, delta_3, delta_4;
+	double one = 1.;
+	unsigned int  j, k, l, current_index;
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+		current_index = m_nodes_id[i];
+		x_coord[i] = coord_array->at(current_index).at(0);
+		y_coord[i] = coord_array->at(current_index).at(1);
+		z_coord[i] = coord_array->at(current_index).at(2);
+	}
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+		j = (i + 1) % NODES_PER_ELEMENT;
+		k = (i + 2) % NODES_PER_ELEMENT;
+		l = (i + 3) % NODES_PER_ELEMENT;
+
+		delta = 0;
+
+		matrix[0][0] = &x_coord[j];
+		matrix[0][1] = &y_coord[j];
+		matrix[0][2] = &z_coord[j];
+
+		matrix[1][0] = &x_coord[k];
+		matrix[1][1] = &y_coord[k];
+		matrix[1][2] = &z_coord[k];
+
+		matrix[2][0] = &x_coord[l];
+		matrix[2][1] = &y_coord[l];
+		matrix[2][2] = &z_coord[l];
+
+		delta += calcDeleterminantPtr(matrix);
+
+		matrix[0][0] = &x_coord[i];
+		matrix[0][1] = &y_coord[i];
+		matrix[0][2] = &z_coord[i];
+
+		delta -= calcDeleterminantPtr(matrix);
+
+		matrix[1][0] = &x_coord[j];
+		matrix[1][1] = &y_coord[j];
+		matrix[1][2] = &z_coord[j];
+
+		delta += calcDeleterminantPtr(matrix);
+
+		matrix[2][0] = &x_coord[k];
+		matrix[2][1] = &y_coord[k];
+		matrix[2][2] = &z_coord[k];
+
+		delta -= calcDeleterminantPtr(matrix);
+
+		matrix[0][0] = &x_coord[j];
+		matrix[0][1] = &y_coord[j];
+		matrix[0][2] = &z_coord[j];
+
+		matrix[1][0] = &x_coord[k];
+		matrix[1][1] = &y_coord[k];
+		matrix[1][2] = &z_coord[k];
+
+		matrix[2][0] = &x_coord[l];
+		matrix[2][1] = &y_coord[l];
+		matrix[2][2] = &z_coord[l];
+
+		delta_1 = calcDeleterminantPtr(matrix);
+
+		matrix[0][0] = &one;
+		matrix[1][0] = &one;
+		matrix[2][0] = &one;
+
+		delta_2 = -calcDeleterminantPtr(matrix);
+
+		matrix[0][1] = &x_coord[j];
+		matrix[1][1] = &x_coord[k];
+		matrix[2][1] = &x_coord[l];
+
+		delta_3 = calcDeleterminantPtr(matrix);
+
+		matrix[0][2] = &y_coord[j];
+		matrix[1][2] = &y_coord[k];
+		matrix[2][2] = &y_coord[l];
+
+		delta_4 = -calcDeleterminantPtr(matrix);
+
+		m_a_coeff.at(i) = delta_1 / delta;
+		m_b_coeff.at(i) = delta_2 / delta;
+		m_c_coeff.at(i) = delta_3 / delta;
+		m_d_coeff.at(i) = delta_4 / delta;
+	}
+}
+
+// The Jacobian with the columns e_k = x_k - x_3 gives the volume, and the rows of its inverse
+// (e_1 x e_2) / det, (e_2 x e_0) / det and (e_0 x e_1) / det are the gradients of the first three shape functions
+void FiniteElement::initGeometry(const vector<array<double, COORDS_PER_NODE>>* coord_array) {
+	const array<double, COORDS_PER_NODE>* nodes[NODES_PER_ELEMENT];
+	double edges[3][COORDS_PER_NODE];
+	double determinant;
+	unsigned int j, k;
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
+		nodes[i] = &coord_array->at(m_nodes_id[i]);
+
+	for (unsigned int i = 0; i < 3; ++i)
+		for (unsigned int l = 0; l < COORDS_PER_NODE; ++l)
+			edges[i][l] = (*nodes[i])[l] - (*nodes[3])[l];
+
+	for (unsigned int i = 0; i < 3; ++i) {
+		j = (i + 1) % 3;
+		k = (i + 2) % 3;
+		m_b_coeff[i] = edges[j][1] * edges[k][2] - edges[j][2] * edges[k][1];
+		m_c_coeff[i] = edges[j][2] * edges[k][0] - edges[j][0] * edges[k][2];
+		m_d_coeff[i] = edges[j][0] * edges[k][1] - edges[j][1] * edges[k][0];
+	}
+
+	determinant = edges[0][0] * m_b_coeff[0] + edges[0][1] * m_c_coeff[0] + edges[0][2] * m_d_coeff[0];
+
+	for (unsigned int i = 0; i < 3; ++i) {
+		m_b_coeff[i] /= determinant;
+		m_c_coeff[i] /= determinant;
+		m_d_coeff[i] /= determinant;
+	}
+
+	m_b_coeff[3] = -(m_b_coeff[0] + m_b_coeff[1] + m_b_coeff[2]);
+	m_c_coeff[3] = -(m_c_coeff[0] + m_c_coeff[1] + m_c_coeff[2]);
+	m_d_coeff[3] = -(m_d_coeff[0] + m_d_coeff[1] + m_d_coeff[2]);
+
+	// a_i is the value of the shape function at the origin, every function is 1 at its own node
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
+		m_a_coeff[i] = -(m_b_coeff[i] * (*nodes[3])[0] + m_c_coeff[i] * (*nodes[3])[1] + m_d_coeff[i] * (*nodes[3])[2]);
+	m_a_coeff[3] += 1.;
+
+	m_volume = determinant / 6.;
+
+	for (unsigned int l = 0; l < COORDS_PER_NODE; ++l)
+		m_center[l] = ((*nodes[0])[l] + (*nodes[1])[l] + (*nodes[2])[l] + (*nodes[3])[l]) / NODES_PER_ELEMENT;
+}
+
+FiniteElement::FiniteElement(unsigned int  id, const array<unsigned int, NODES_PER_ELEMENT>* nodes_id,
+	const vector<array<double, COORDS_PER_NODE>>* coord_array, ElementGeometryType geometry_type) :
+	m_id(id) {
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
+		m_nodes_id.at(i) = nodes_id->at(i);
+
+	if (geometry_type != DETERMINANT_GEOMETRY) {
+		initGeometry(coord_array);
+		return;
+	}
+
+	initCenter(coord_array);
+	initVolume(coord_array);
+	initShapeFunctions(coord_array);
+}
+
+FiniteElement::FiniteElement(unsigned int  id, const array<unsigned int, NODES_PER_ELEMENT>* nodes_id, const double* geometry) :
+	m_id(id), m_nodes_id(*nodes_id) {
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+		m_a_coeff.at(i) = geometry[i];
+		m_b_coeff.at(i) = geometry[NODES_PER_ELEMENT + i];
+		m_c_coeff.at(i) = geometry[2 * NODES_PER_ELEMENT + i];
+		m_d_coeff.at(i) = geometry[3 * NODES_PER_ELEMENT + i];
+	}
+
+	m_volume = geometry[4 * NODES_PER_ELEMENT];
+
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+		m_center.at(i) = geometry[4 * NODES_PER_ELEMENT + 1 + i];
+}
+
+unsigned int  FiniteElement::getID() const {
+	return m_id;
+}
+
+// The local order of the nodes is kept, so the shape functions stay valid
+void FiniteElement::renumber(unsigned int id, const vector<unsigned int>* new_node_ids) {
+	m_id = id;
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
+		m_nodes_id.at(i) = new_node_ids->at(m_nodes_id.at(i));
+}
+
+const array<unsigned int, NODES_PER_ELEMENT>* FiniteElement::getNodesId() const {
+	return &m_nodes_id;
+}
+
+const array<double, COORDS_PER_NODE>* FiniteElement::getCenter() const {
+	return &m_center;
+}
+
+double FiniteElement::getVolume() const {
+	return m_volume;
+}
+
+void FiniteElement::getGeometry(double* geometry) const {
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i) {
+		geometry[i] = m_a_coeff.at(i);
+		geometry[NODES_PER_ELEMENT + i] = m_b_coeff.at(i);
+		geometry[2 * NODES_PER_ELEMENT + i] = m_c_coeff.at(i);
+		geometry[3 * NODES_PER_ELEMENT + i] = m_d_coeff.at(i);
+	}
+
+	geometry[4 * NODES_PER_ELEMENT] = m_volume;
+
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+		geometry[4 * NODES_PER_ELEMENT + 1 + i] = m_center.at(i);
+}
+
+const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsA() const {
+	return &m_a_coeff;
+}
+
+const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsB() const {
+	return &m_b_coeff;
+}
+
+const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsC() const {
+	return &m_c_coeff;
+}
+
+const array<double, NODES_PER_ELEMENT>* FiniteElement::getCoeffsD() const {
+	return &m_d_coeff;
+}
+
+void FiniteElement::setupLocalNumeration(array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration) {
+	local_numeration->at(0) = { 0,1,2 };
+	local_numeration->at(1) = { 1,2,3 };
+	local_numeration->at(2) = { 0,1,3 };
+	local_numeration->at(3) = { 0,2,3 };
+}
+
+double FiniteElement::calcDeterminant(const double matrix[][3]) const {
+	return
+		matrix[0][0] * matrix[1][1] * matrix[2][2] + matrix[0][1] * matrix[1][2] * matrix[2][0] +
+		matrix[0][2] * matrix[1][0] * matrix[2][1] - matrix[0][2] * matrix[1][1] * matrix[2][0] -
+		matrix[0][1] * matrix[1][0] * matrix[2][2] - matrix[0][0] * matrix[1][2] * matrix[2][1];
 }
\ No newline at end of file
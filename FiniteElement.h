@@ -1,37 +1,52 @@
-#pragma once
-#include <array>
-#include <vector>
-#include <map>
-#include <cmath>
-#include <iostream>
-#include "Defines.h"
-
-using namespace std;
-
-class FiniteElement {
-private:
-	unsigned int  m_id;
-	array<unsigned int, NODES_PER_ELEMENT> m_nodes_id;
-	array<double, COORDS_PER_NODE> m_center;
-	array<double, NODES_PER_ELEMENT> m_a_coeff, m_b_coeff, m_c_coeff, m_d_coeff;
-	double m_volume;
-
-private:
-	void initCenter(const vector<array<double, COORDS_PER_NODE>>* coord_array);
-	void initVolume(const vector<array<double, COORDS_PER_NODE>>* coord_array);
-	void initShapeFunctions(const vector<array<double, COORDS_PER_NODE>>* coord_array);
-	double calcDeleterminantPtr(double* matrix[3][3]) const;
-	double calcDeterminant(const double matrix[][3]) const;
-
-public:
-	FiniteElement(unsigned int  id, const array<unsigned int, NODES_PER_ELEMENT>* nodes_id,
-				  const vector<array<double, COORDS_PER_NODE>>* coord_array);
-	unsigned int  getID() const;
-	const array<unsigned int, NODES_PER_ELEMENT>* getNodesId() const;
-	const array<double, COORDS_PER_NODE>* getCenter() const;
-	const array<double, NODES_PER_ELEMENT>* getCoeffsA() const;
-	const array<double, NODES_PER_ELEMENT>* getCoeffsB() const;
-	const array<double, NODES_PER_ELEMENT>* getCoeffsC() const;
-	const array<double, NODES_PER_ELEMENT>* getCoeffsD() const;
-	double getVolume() const;
+#pragma once
+#include <array>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <iostream>
+#include "Defines.h"
+
+using namespace std;
+
+// BATCHED_GEOMETRY runs the vectorized kernel over the whole mesh in DataLoader, a single element
+// falls back to JACOBIAN_GEOMETRY. DETERMINANT_GEOMETRY is the original cofactor expansion
+enum ElementGeometryType {
+	JACOBIAN_GEOMETRY,
+	BATCHED_GEOMETRY,
+	DETERMINANT_GEOMETRY,
+};
+
+class FiniteElement {
+private:
+	unsigned int  m_id;
+	array<unsigned int, NODES_PER_ELEMENT> m_nodes_id;
+	array<double, COORDS_PER_NODE> m_center;
+	array<double, NODES_PER_ELEMENT> m_a_coeff, m_b_coeff, m_c_coeff, m_d_coeff;
+	double m_volume;
+
+private:
+	void initCenter(const vector<array<double, COORDS_PER_NODE>>* coord_array);
+	void initVolume(const vector<array<double, COORDS_PER_NODE>>* coord_array);
+	void initShapeFunctions(const vector<array<double, COORDS_PER_NODE>>* coord_array);
+	void initGeometry(const vector<array<double, COORDS_PER_NODE>>* coord_array);
+	double calcDeleterminantPtr(double* matrix[3][3]) const;
+	double calcDeterminant(const double matrix[][3]) const;
+
+public:
+	FiniteElement(unsigned int  id, const array<unsigned int, NODES_PER_ELEMENT>* nodes_id,
+				  const vector<array<double, COORDS_PER_NODE>>* coord_array, ElementGeometryType geometry_type = JACOBIAN_GEOMETRY);
+	FiniteElement(unsigned int  id, const array<unsigned int, NODES_PER_ELEMENT>* nodes_id, const double* geometry);
+	unsigned int  getID() const;
+	const array<unsigned int, NODES_PER_ELEMENT>* getNodesId() const;
+	const array<double, COORDS_PER_NODE>* getCenter() const;
+	const array<double, NODES_PER_ELEMENT>* getCoeffsA() const;
+	const array<double, NODES_PER_ELEMENT>* getCoeffsB() const;
+	const array<double, NODES_PER_ELEMENT>* getCoeffsC() const;
+	const array<double, NODES_PER_ELEMENT>* getCoeffsD() const;
+	double getVolume() const;
+	void getGeometry(double* geometry) const;
+	void renumber(unsigned int id, const vector<unsigned int>* new_node_ids);
+
+public:
+	static void setupLocalNumeration(array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration);
 };
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_file_handle(INVALID_HANDLE_VALUE), m_mapping_handle(nullptr) {
+}
+#else
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_file_descriptor(-1) {
+}
+#endif
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const string& file_path) {
+	LARGE_INTEGER file_size;
+
+	close();
+
+	m_file_handle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_file_handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	if (!GetFileSizeEx(m_file_handle, &file_size)) {
+		close();
+		return false;
+	}
+
+	m_size = static_cast<size_t>(file_size.QuadPart);
+	if (m_size == 0)
+		return true;
+
+	m_mapping_handle = CreateFileMappingA(m_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping_handle == nullptr) {
+		close();
+		return false;
+	}
+
+	m_data = static_cast<const char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+
+	if (m_mapping_handle != nullptr)
+		CloseHandle(m_mapping_handle);
+
+	if (m_file_handle != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file_handle);
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping_handle = nullptr;
+	m_file_handle = INVALID_HANDLE_VALUE;
+}
+
+bool MappedFile::isOpen() const {
+	return m_file_handle != INVALID_HANDLE_VALUE;
+}
+#else
+bool MappedFile::open(const string& file_path) {
+	struct stat file_stat;
+	void* data;
+
+	close();
+
+	m_file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+	if (m_file_descriptor < 0)
+		return false;
+
+	if (fstat(m_file_descriptor, &file_stat) != 0) {
+		close();
+		return false;
+	}
+
+	m_size = static_cast<size_t>(file_stat.st_size);
+	if (m_size == 0)
+		return true;
+
+	data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file_descriptor, 0);
+	if (data == MAP_FAILED) {
+		close();
+		return false;
+	}
+
+	madvise(data, m_size, MADV_SEQUENTIAL);
+	m_data = static_cast<const char*>(data);
+
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data != nullptr)
+		munmap(const_cast<char*>(m_data), m_size);
+
+	if (m_file_descriptor >= 0)
+		::close(m_file_descriptor);
+
+	m_data = nullptr;
+	m_size = 0;
+	m_file_descriptor = -1;
+}
+
+bool MappedFile::isOpen() const {
+	return m_file_descriptor >= 0;
+}
+#endif
+
+const char* MappedFile::getData() const {
+	return m_data;
+}
+
+size_t MappedFile::getSize() const {
+	return m_size;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+class MappedFile {
+private:
+	const char* m_data;
+	size_t m_size;
+#ifdef _WIN32
+	void* m_file_handle;
+	void* m_mapping_handle;
+#else
+	int m_file_descriptor;
+#endif
+
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	bool open(const string& file_path);
+	void close();
+	bool isOpen() const;
+	const char* getData() const;
+	size_t getSize() const;
+};
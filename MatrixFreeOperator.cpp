@@ -0,0 +1,161 @@
+#include "MatrixFreeOperator.h"
+
+MatrixFreeOperator::MatrixFreeOperator() : m_number_of_nodes(0), m_heat_conduction_coeff(0) {
+}
+
+// Face matrices are given per boundary face, only the nonzero ones are kept
+void MatrixFreeOperator::init(const DataLoader* data_loader, double heat_conduction_coeff,
+	const vector<array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>>* face_matrices,
+	const vector<bool>* is_constrained) {
+	unsigned int number_of_elements = data_loader->getElementCount();
+	const array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* current_matrix;
+	array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT> local_matrix;
+	ElementBatchMatrices batch_matrices;
+	bool is_zero;
+
+	m_number_of_nodes = data_loader->getNodeCount();
+	m_heat_conduction_coeff = heat_conduction_coeff;
+	m_is_constrained = *is_constrained;
+	m_element_store.init(data_loader, nullptr);
+
+	m_elements_nodes_id.resize(number_of_elements);
+	m_face_matrices_ptr.assign(number_of_elements + 1, 0);
+	m_face_matrices.clear();
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		m_elements_nodes_id[i] = *data_loader->getElement(i)->getNodesId();
+
+		for (unsigned int j = data_loader->getElementBoundaryFacesBegin(i); j < data_loader->getElementBoundaryFacesEnd(i); ++j) {
+			current_matrix = &face_matrices->at(j);
+			is_zero = true;
+
+			for (unsigned int k = 0; k < NODES_PER_ELEMENT && is_zero; ++k)
+				for (unsigned int l = 0; l < NODES_PER_ELEMENT && is_zero; ++l)
+					is_zero = current_matrix->at(k).at(l) == 0;
+
+			if (!is_zero)
+				m_face_matrices.push_back(*current_matrix);
+		}
+
+		m_face_matrices_ptr[i + 1] = m_face_matrices.size();
+	}
+
+	m_diagonal.setZero(m_number_of_nodes);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		if (i % ELEMENT_BATCH_SIZE == 0)
+			m_element_store.computeLocalMatrices(i, m_heat_conduction_coeff, &batch_matrices);
+		ElementKernels::getLocalMatrix(&batch_matrices, i % ELEMENT_BATCH_SIZE, &local_matrix);
+
+		for (unsigned int j = m_face_matrices_ptr[i]; j < m_face_matrices_ptr[i + 1]; ++j)
+			for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+				local_matrix[k][k] += m_face_matrices[j][k][k];
+
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			m_diagonal(m_elements_nodes_id[i][k]) += local_matrix[k][k];
+	}
+
+	m_accumulators.clear();
+}
+
+// Every thread sums its chunk of elements into a private vector, the first thread directly into the result.
+// The private vectors are added in thread order and zeroed again for the next product
+void MatrixFreeOperator::multiplyElements(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const {
+	unsigned int number_of_elements = m_elements_nodes_id.size();
+
+	if (m_accumulators.size() < number_of_threads)
+		m_accumulators.resize(number_of_threads, Eigen::VectorXd::Zero(m_number_of_nodes));
+
+	result->setZero(m_number_of_nodes);
+
+	parallelFor(0, number_of_elements, number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+		Eigen::VectorXd* accumulator = thread_id == 0 ? result : &m_accumulators[thread_id];
+		const array<unsigned int, NODES_PER_ELEMENT>* current_nodes_id;
+		const array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* current_matrix;
+		ElementBatchValues batch_x, batch_result;
+		unsigned int batch_size, current_elem_id;
+
+		for (unsigned int first = begin; first < end; first += ELEMENT_BATCH_SIZE) {
+			batch_size = min(end - first, (unsigned int)ELEMENT_BATCH_SIZE);
+
+			for (unsigned int lane = 0; lane < ELEMENT_BATCH_SIZE; ++lane) {
+				current_nodes_id = &m_elements_nodes_id[lane < batch_size ? first + lane : first];
+				for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+					batch_x.values[k][lane] = (*x)((*current_nodes_id)[k]);
+			}
+
+			m_element_store.applyStiffness(first, m_heat_conduction_coeff, &batch_x, &batch_result);
+
+			for (unsigned int lane = 0; lane < batch_size; ++lane) {
+				current_elem_id = first + lane;
+
+				for (unsigned int j = m_face_matrices_ptr[current_elem_id]; j < m_face_matrices_ptr[current_elem_id + 1]; ++j) {
+					current_matrix = &m_face_matrices[j];
+					for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+						for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
+							batch_result.values[k][lane] += (*current_matrix)[k][l] * batch_x.values[l][lane];
+				}
+
+				current_nodes_id = &m_elements_nodes_id[current_elem_id];
+				for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+					(*accumulator)((*current_nodes_id)[k]) += batch_result.values[k][lane];
+			}
+		}
+	});
+
+	if (number_of_threads <= 1)
+		return;
+
+	parallelFor(0, m_number_of_nodes, number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int t = 1; t < number_of_threads; ++t)
+			for (unsigned int i = begin; i < end; ++i) {
+				(*result)(i) += m_accumulators[t](i);
+				m_accumulators[t](i) = 0;
+			}
+	});
+}
+
+void MatrixFreeOperator::multiply(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const {
+	m_free_values = *x;
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i)
+		if (m_is_constrained[i])
+			m_free_values(i) = 0;
+
+	multiplyElements(&m_free_values, result, number_of_threads);
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i)
+		if (m_is_constrained[i])
+			(*result)(i) = m_diagonal(i) * (*x)(i);
+}
+
+// The product with the full matrix, used to move the constrained values to the right hand side
+void MatrixFreeOperator::multiplyUnconstrained(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const {
+	multiplyElements(x, result, number_of_threads);
+}
+
+const Eigen::VectorXd* MatrixFreeOperator::getDiagonal() const {
+	return &m_diagonal;
+}
+
+unsigned long long MatrixFreeOperator::getMemorySize() const {
+	return m_element_store.getMemorySize() +
+		m_elements_nodes_id.capacity() * sizeof(array<unsigned int, NODES_PER_ELEMENT>) +
+		m_face_matrices_ptr.capacity() * sizeof(unsigned int) +
+		m_face_matrices.capacity() * sizeof(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>) +
+		m_is_constrained.capacity() / 8 + m_diagonal.size() * sizeof(double);
+}
+
+void MatrixFreeOperator::clear() {
+	m_number_of_nodes = 0;
+	m_element_store.clear();
+	m_elements_nodes_id.clear();
+	m_elements_nodes_id.shrink_to_fit();
+	m_face_matrices_ptr.clear();
+	m_face_matrices_ptr.shrink_to_fit();
+	m_face_matrices.clear();
+	m_face_matrices.shrink_to_fit();
+	m_is_constrained.clear();
+	m_diagonal.resize(0);
+	m_free_values.resize(0);
+	m_accumulators.clear();
+}
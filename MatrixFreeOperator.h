@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "./lib/eigen/Dense"
+#include "DataLoader.h"
+#include "CsrMatrix.h"
+#include "ElementStore.h"
+#include "ElementKernels.h"
+#include "Parallel.h"
+#include "Defines.h"
+
+using namespace std;
+
+// Applies the global matrix element by element from the stored shape function gradients, so its memory
+// grows with the number of elements instead of the number of nonzeros. Environment heat exchange faces
+// keep their own local matrices. Constrained nodes act as eliminated rows and columns with the
+// assembled diagonal left on them, which matches ELIMINATION_DIRICHLET
+class MatrixFreeOperator : public LinearOperator {
+private:
+	unsigned int m_number_of_nodes;
+	double m_heat_conduction_coeff;
+	ElementStore m_element_store;
+	vector<array<unsigned int, NODES_PER_ELEMENT>> m_elements_nodes_id;
+	vector<unsigned int> m_face_matrices_ptr;
+	vector<array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>> m_face_matrices;
+	vector<bool> m_is_constrained;
+	Eigen::VectorXd m_diagonal;
+	mutable Eigen::VectorXd m_free_values;
+	mutable vector<Eigen::VectorXd> m_accumulators;
+
+private:
+	void multiplyElements(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const;
+
+public:
+	MatrixFreeOperator();
+	void init(const DataLoader* data_loader, double heat_conduction_coeff,
+			  const vector<array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>>* face_matrices,
+			  const vector<bool>* is_constrained);
+	void multiply(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const override;
+	void multiplyUnconstrained(const Eigen::VectorXd* x, Eigen::VectorXd* result, unsigned int number_of_threads) const;
+	const Eigen::VectorXd* getDiagonal() const;
+	unsigned long long getMemorySize() const;
+	void clear();
+};
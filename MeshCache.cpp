@@ -0,0 +1,164 @@
+#include "MeshCache.h"
+
+MeshCache::MeshCache() :
+	m_header(nullptr), m_coords(nullptr), m_elements(nullptr), m_edges(nullptr), m_geometry(nullptr), m_row_ptr(nullptr), m_col_ids(nullptr) {
+}
+
+bool MeshCache::isMeshCache(const char* data, size_t size) {
+	return size >= sizeof(MeshCacheHeader) && memcmp(data, MESH_CACHE_MAGIC, sizeof(MeshCacheHeader::magic)) == 0;
+}
+
+// 64-bit FNV-1a over whole words and then the remaining bytes. An edit that keeps the size of
+// the source, like a changed digit, still changes the hash
+uint64_t MeshCache::getSourceHash(const char* data, size_t size) {
+	uint64_t hash = 14695981039346656037ull;
+	uint64_t word;
+	size_t i = 0;
+
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		memcpy(&word, data + i, sizeof(uint64_t));
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+
+	for (; i < size; ++i)
+		hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+
+	return hash;
+}
+
+bool MeshCache::open(const string& file_path) {
+	const char* data;
+	size_t expected_size;
+
+	close();
+
+	if (!m_file.open(file_path))
+		return false;
+
+	data = m_file.getData();
+	if (!isMeshCache(data, m_file.getSize())) {
+		close();
+		return false;
+	}
+
+	m_header = reinterpret_cast<const MeshCacheHeader*>(data);
+	if (m_header->version != MESH_CACHE_VERSION) {
+		close();
+		return false;
+	}
+
+	expected_size = sizeof(MeshCacheHeader);
+	expected_size += sizeof(double) * COORDS_PER_NODE * m_header->number_of_nodes;
+	expected_size += sizeof(uint32_t) * NODES_PER_ELEMENT * m_header->number_of_elements;
+	expected_size += sizeof(uint32_t) * (NODES_PER_EDGE + 1) * m_header->number_of_edges;
+	if (m_header->flags & MESH_CACHE_GEOMETRY_FLAG)
+		expected_size += sizeof(double) * ELEMENT_GEOMETRY_SIZE * m_header->number_of_elements;
+	if (m_header->flags & MESH_CACHE_PATTERN_FLAG)
+		expected_size += sizeof(int32_t) * (m_header->number_of_nodes + 1 + m_header->pattern_size);
+
+	if (m_file.getSize() != expected_size) {
+		close();
+		return false;
+	}
+
+	data += sizeof(MeshCacheHeader);
+	m_coords = reinterpret_cast<const double*>(data);
+	data += sizeof(double) * COORDS_PER_NODE * m_header->number_of_nodes;
+	m_elements = reinterpret_cast<const uint32_t*>(data);
+	data += sizeof(uint32_t) * NODES_PER_ELEMENT * m_header->number_of_elements;
+	m_edges = reinterpret_cast<const uint32_t*>(data);
+	data += sizeof(uint32_t) * (NODES_PER_EDGE + 1) * m_header->number_of_edges;
+
+	if (m_header->flags & MESH_CACHE_GEOMETRY_FLAG) {
+		m_geometry = reinterpret_cast<const double*>(data);
+		data += sizeof(double) * ELEMENT_GEOMETRY_SIZE * m_header->number_of_elements;
+	}
+
+	if (m_header->flags & MESH_CACHE_PATTERN_FLAG) {
+		m_row_ptr = reinterpret_cast<const int32_t*>(data);
+		data += sizeof(int32_t) * (m_header->number_of_nodes + 1);
+		m_col_ids = reinterpret_cast<const int32_t*>(data);
+	}
+
+	return true;
+}
+
+void MeshCache::close() {
+	m_file.close();
+	m_header = nullptr;
+	m_coords = nullptr;
+	m_elements = nullptr;
+	m_edges = nullptr;
+	m_geometry = nullptr;
+	m_row_ptr = nullptr;
+	m_col_ids = nullptr;
+}
+
+bool MeshCache::isOpen() const {
+	return m_header != nullptr;
+}
+
+const MeshCacheHeader* MeshCache::getHeader() const {
+	return m_header;
+}
+
+const double* MeshCache::getCoords() const {
+	return m_coords;
+}
+
+const uint32_t* MeshCache::getElements() const {
+	return m_elements;
+}
+
+const uint32_t* MeshCache::getEdges() const {
+	return m_edges;
+}
+
+const double* MeshCache::getGeometry() const {
+	return m_geometry;
+}
+
+const int32_t* MeshCache::getRowPtr() const {
+	return m_row_ptr;
+}
+
+const int32_t* MeshCache::getColIds() const {
+	return m_col_ids;
+}
+
+bool MeshCache::write(const string& file_path, const MeshCacheHeader* header, const double* coords, const uint32_t* elements,
+	const uint32_t* edges, const double* geometry, const int32_t* row_ptr, const int32_t* col_ids) {
+	ofstream file;
+	MeshCacheHeader file_header = *header;
+
+	memcpy(file_header.magic, MESH_CACHE_MAGIC, sizeof(file_header.magic));
+	file_header.version = MESH_CACHE_VERSION;
+	file_header.flags = 0;
+	if (geometry != nullptr)
+		file_header.flags |= MESH_CACHE_GEOMETRY_FLAG;
+	if (row_ptr != nullptr && col_ids != nullptr)
+		file_header.flags |= MESH_CACHE_PATTERN_FLAG;
+	else
+		file_header.pattern_size = 0;
+
+	file.open(file_path, ios::out | ios::binary | ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	file.write(reinterpret_cast<const char*>(&file_header), sizeof(MeshCacheHeader));
+	file.write(reinterpret_cast<const char*>(coords), sizeof(double) * COORDS_PER_NODE * file_header.number_of_nodes);
+	file.write(reinterpret_cast<const char*>(elements), sizeof(uint32_t) * NODES_PER_ELEMENT * file_header.number_of_elements);
+	file.write(reinterpret_cast<const char*>(edges), sizeof(uint32_t) * (NODES_PER_EDGE + 1) * file_header.number_of_edges);
+
+	if (file_header.flags & MESH_CACHE_GEOMETRY_FLAG)
+		file.write(reinterpret_cast<const char*>(geometry), sizeof(double) * ELEMENT_GEOMETRY_SIZE * file_header.number_of_elements);
+
+	if (file_header.flags & MESH_CACHE_PATTERN_FLAG) {
+		file.write(reinterpret_cast<const char*>(row_ptr), sizeof(int32_t) * (file_header.number_of_nodes + 1));
+		file.write(reinterpret_cast<const char*>(col_ids), sizeof(int32_t) * file_header.pattern_size);
+	}
+
+	file.close();
+
+	return !file.fail();
+}
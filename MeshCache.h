@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include "MappedFile.h"
+#include "Defines.h"
+
+using namespace std;
+
+#define MESH_CACHE_MAGIC "TSMESH\0"
+#define MESH_CACHE_VERSION 2
+#define MESH_CACHE_GEOMETRY_FLAG 1
+#define MESH_CACHE_PATTERN_FLAG 2
+
+struct MeshCacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t flags;
+	uint64_t source_size;
+	uint64_t source_hash;
+	uint32_t number_of_nodes;
+	uint32_t number_of_elements;
+	uint32_t number_of_edges;
+	uint32_t pattern_size;
+	double max_coord;
+	double object_center[COORDS_PER_NODE];
+};
+
+// Sections follow the header in this order: node coordinates, element node ids,
+// boundary edges as (surface id, three node ids), element geometry and the
+// sparsity pattern of the global matrix. The last two are optional
+class MeshCache {
+private:
+	MappedFile m_file;
+	const MeshCacheHeader* m_header;
+	const double* m_coords;
+	const uint32_t* m_elements;
+	const uint32_t* m_edges;
+	const double* m_geometry;
+	const int32_t* m_row_ptr;
+	const int32_t* m_col_ids;
+
+public:
+	MeshCache();
+	bool open(const string& file_path);
+	void close();
+	bool isOpen() const;
+	const MeshCacheHeader* getHeader() const;
+	const double* getCoords() const;
+	const uint32_t* getElements() const;
+	const uint32_t* getEdges() const;
+	const double* getGeometry() const;
+	const int32_t* getRowPtr() const;
+	const int32_t* getColIds() const;
+
+public:
+	static bool isMeshCache(const char* data, size_t size);
+	static uint64_t getSourceHash(const char* data, size_t size);
+	static bool write(const string& file_path, const MeshCacheHeader* header, const double* coords, const uint32_t* elements,
+					  const uint32_t* edges, const double* geometry, const int32_t* row_ptr, const int32_t* col_ids);
+};
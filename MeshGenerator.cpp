@@ -0,0 +1,230 @@
+#include "MeshGenerator.h"
+
+MeshGenerator::MeshGenerator() {
+	m_cells.fill(1);
+	m_size.fill(1.);
+}
+
+bool MeshGenerator::setCellCount(unsigned int x_cells, unsigned int y_cells, unsigned int z_cells) {
+	unsigned long long number_of_nodes = (x_cells + 1ull) * (y_cells + 1ull) * (z_cells + 1ull);
+	unsigned long long number_of_elements = TETRAHEDRONS_PER_CELL * (unsigned long long)x_cells * y_cells * z_cells;
+
+	if (x_cells == 0 || y_cells == 0 || z_cells == 0 || number_of_nodes > UINT32_MAX || number_of_elements > UINT32_MAX)
+		return false;
+
+	m_cells = { x_cells, y_cells, z_cells };
+
+	return true;
+}
+
+bool MeshGenerator::setSize(double x_size, double y_size, double z_size) {
+	if (!(x_size > 0) || !(y_size > 0) || !(z_size > 0))
+		return false;
+
+	m_size = { x_size, y_size, z_size };
+
+	return true;
+}
+
+unsigned long long MeshGenerator::getNodeCount() const {
+	return (m_cells[0] + 1ull) * (m_cells[1] + 1ull) * (m_cells[2] + 1ull);
+}
+
+unsigned long long MeshGenerator::getElementCount() const {
+	return TETRAHEDRONS_PER_CELL * (unsigned long long)m_cells[0] * m_cells[1] * m_cells[2];
+}
+
+unsigned long long MeshGenerator::getBoundaryFaceCount() const {
+	return 4 * ((unsigned long long)m_cells[0] * m_cells[1] + (unsigned long long)m_cells[1] * m_cells[2] +
+		(unsigned long long)m_cells[0] * m_cells[2]);
+}
+
+unsigned int MeshGenerator::getNodeId(unsigned int i, unsigned int j, unsigned int k) const {
+	return i + (m_cells[0] + 1) * (j + (m_cells[1] + 1) * k);
+}
+
+void MeshGenerator::getNodeCoord(unsigned int id, array<double, COORDS_PER_NODE>* coord) const {
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i) {
+		coord->at(i) = m_size[i] * (id % (m_cells[i] + 1)) / m_cells[i];
+		id /= m_cells[i] + 1;
+	}
+}
+
+void MeshGenerator::getCellElements(unsigned int i, unsigned int j, unsigned int k,
+	array<array<unsigned int, NODES_PER_ELEMENT>, TETRAHEDRONS_PER_CELL>* elements) const {
+	// corners are numbered by bits: 1 = x, 2 = y, 4 = z. Every tetrahedron goes from
+	// corner 0 to corner 7 along the cell edges, one per order of the three axes
+	const unsigned int paths[TETRAHEDRONS_PER_CELL][COORDS_PER_NODE] = {
+		{ 1, 2, 4 }, { 1, 4, 2 }, { 2, 1, 4 }, { 2, 4, 1 }, { 4, 1, 2 }, { 4, 2, 1 } };
+	array<unsigned int, NODES_PER_ELEMENT> corners;
+	int edges[COORDS_PER_NODE][COORDS_PER_NODE];
+	int determinant;
+
+	for (unsigned int t = 0; t < TETRAHEDRONS_PER_CELL; ++t) {
+		corners = { 0, paths[t][0], paths[t][0] | paths[t][1], 7 };
+
+		// FiniteElement needs det[x0 - x3, x1 - x3, x2 - x3] > 0
+		for (unsigned int n = 0; n < COORDS_PER_NODE; ++n)
+			for (unsigned int c = 0; c < COORDS_PER_NODE; ++c)
+				edges[c][n] = ((corners[n] >> c) & 1) - ((corners[3] >> c) & 1);
+
+		determinant =
+			edges[0][0] * edges[1][1] * edges[2][2] + edges[0][1] * edges[1][2] * edges[2][0] +
+			edges[0][2] * edges[1][0] * edges[2][1] - edges[0][2] * edges[1][1] * edges[2][0] -
+			edges[0][1] * edges[1][0] * edges[2][2] - edges[0][0] * edges[1][2] * edges[2][1];
+
+		if (determinant < 0)
+			swap(corners[0], corners[1]);
+
+		for (unsigned int n = 0; n < NODES_PER_ELEMENT; ++n)
+			elements->at(t).at(n) = getNodeId(i + (corners[n] & 1), j + ((corners[n] >> 1) & 1), k + ((corners[n] >> 2) & 1));
+	}
+}
+
+void MeshGenerator::getSideCells(unsigned int side, unsigned int* first_count, unsigned int* second_count) const {
+	unsigned int axis = side / 2;
+
+	*first_count = m_cells[axis == 0 ? 1 : 0];
+	*second_count = m_cells[axis == 2 ? 1 : 2];
+}
+
+void MeshGenerator::getSideFaces(unsigned int side, unsigned int first, unsigned int second,
+	vector<array<unsigned int, NODES_PER_EDGE>>* faces) const {
+	unsigned int axis = side / 2;
+	unsigned int plane = side % 2 == 0 ? 0 : m_cells[axis];
+	unsigned int node_id, node_plane;
+	array<unsigned int, COORDS_PER_NODE> cell;
+	array<array<unsigned int, NODES_PER_ELEMENT>, TETRAHEDRONS_PER_CELL> elements;
+	array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT> local_numeration;
+	array<unsigned int, NODES_PER_EDGE> face;
+	bool is_on_side;
+
+	cell[axis] = side % 2 == 0 ? 0 : m_cells[axis] - 1;
+	cell[axis == 0 ? 1 : 0] = first;
+	cell[axis == 2 ? 1 : 2] = second;
+
+	FiniteElement::setupLocalNumeration(&local_numeration);
+	getCellElements(cell[0], cell[1], cell[2], &elements);
+
+	faces->clear();
+
+	for (unsigned int t = 0; t < TETRAHEDRONS_PER_CELL; ++t)
+		for (unsigned int f = 0; f < EDGES_PER_ELEMENT; ++f) {
+			is_on_side = true;
+
+			for (unsigned int n = 0; n < NODES_PER_EDGE; ++n) {
+				node_id = elements[t][local_numeration[f][n]];
+				face[n] = node_id;
+
+				node_plane = node_id;
+				for (unsigned int c = 0; c < axis; ++c)
+					node_plane /= m_cells[c] + 1;
+				node_plane %= m_cells[axis] + 1;
+
+				if (node_plane != plane)
+					is_on_side = false;
+			}
+
+			if (is_on_side)
+				faces->push_back(face);
+		}
+}
+
+bool MeshGenerator::writeNeutralFile(const string& file_path) const {
+	ofstream file;
+	array<double, COORDS_PER_NODE> coord;
+	array<array<unsigned int, NODES_PER_ELEMENT>, TETRAHEDRONS_PER_CELL> elements;
+	vector<array<unsigned int, NODES_PER_EDGE>> faces;
+	unsigned int first_count, second_count;
+
+	file.open(file_path, ios::out | ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	file << setprecision(12);
+
+	file << getNodeCount() << endl;
+	for (unsigned int i = 0; i < getNodeCount(); ++i) {
+		getNodeCoord(i, &coord);
+		file << "  " << coord[0] << "  " << coord[1] << "  " << coord[2] << '\n';
+	}
+
+	file << getElementCount() << endl;
+	for (unsigned int k = 0; k < m_cells[2]; ++k)
+		for (unsigned int j = 0; j < m_cells[1]; ++j)
+			for (unsigned int i = 0; i < m_cells[0]; ++i) {
+				getCellElements(i, j, k, &elements);
+				for (unsigned int t = 0; t < TETRAHEDRONS_PER_CELL; ++t)
+					file << "   1   " << elements[t][0] + 1 << ' ' << elements[t][1] + 1 << ' '
+						<< elements[t][2] + 1 << ' ' << elements[t][3] + 1 << '\n';
+			}
+
+	file << getBoundaryFaceCount() << endl;
+	for (unsigned int side = 0; side < BOX_SIDES; ++side) {
+		getSideCells(side, &first_count, &second_count);
+		for (unsigned int second = 0; second < second_count; ++second)
+			for (unsigned int first = 0; first < first_count; ++first) {
+				getSideFaces(side, first, second, &faces);
+				for (unsigned int f = 0; f < faces.size(); ++f)
+					file << "   " << side + 1 << "   " << faces[f][0] + 1 << ' ' << faces[f][1] + 1 << ' ' << faces[f][2] + 1 << '\n';
+			}
+	}
+
+	file.close();
+
+	return !file.fail();
+}
+
+bool MeshGenerator::writeBinaryFile(const string& file_path) const {
+	ofstream file;
+	MeshCacheHeader header;
+	array<double, COORDS_PER_NODE> coord;
+	array<array<unsigned int, NODES_PER_ELEMENT>, TETRAHEDRONS_PER_CELL> elements;
+	vector<array<unsigned int, NODES_PER_EDGE>> faces;
+	array<uint32_t, NODES_PER_EDGE + 1> edge;
+	unsigned int first_count, second_count;
+
+	memset(&header, 0, sizeof(MeshCacheHeader));
+	memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic));
+	header.version = MESH_CACHE_VERSION;
+	header.number_of_nodes = getNodeCount();
+	header.number_of_elements = getElementCount();
+	header.number_of_edges = getBoundaryFaceCount();
+	header.max_coord = *max_element(m_size.begin(), m_size.end());
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+		header.object_center[i] = m_size[i] / 2;
+
+	file.open(file_path, ios::out | ios::binary | ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader));
+
+	for (unsigned int i = 0; i < getNodeCount(); ++i) {
+		getNodeCoord(i, &coord);
+		file.write(reinterpret_cast<const char*>(coord.data()), sizeof(double) * COORDS_PER_NODE);
+	}
+
+	for (unsigned int k = 0; k < m_cells[2]; ++k)
+		for (unsigned int j = 0; j < m_cells[1]; ++j)
+			for (unsigned int i = 0; i < m_cells[0]; ++i) {
+				getCellElements(i, j, k, &elements);
+				file.write(reinterpret_cast<const char*>(elements.data()), sizeof(uint32_t) * NODES_PER_ELEMENT * TETRAHEDRONS_PER_CELL);
+			}
+
+	for (unsigned int side = 0; side < BOX_SIDES; ++side) {
+		getSideCells(side, &first_count, &second_count);
+		for (unsigned int second = 0; second < second_count; ++second)
+			for (unsigned int first = 0; first < first_count; ++first) {
+				getSideFaces(side, first, second, &faces);
+				for (unsigned int f = 0; f < faces.size(); ++f) {
+					edge = { side, faces[f][0], faces[f][1], faces[f][2] };
+					file.write(reinterpret_cast<const char*>(edge.data()), sizeof(uint32_t) * (NODES_PER_EDGE + 1));
+				}
+			}
+	}
+
+	file.close();
+
+	return !file.fail();
+}
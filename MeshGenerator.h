@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include "FiniteElement.h"
+#include "MeshCache.h"
+#include "Defines.h"
+
+using namespace std;
+
+#define TETRAHEDRONS_PER_CELL 6
+#define BOX_SIDES 6
+
+// Structured tetrahedral mesh of an axis aligned box. Every hexahedral cell is
+// split into six tetrahedrons along its main diagonal, so neighbouring cells share
+// the same face diagonals. The box sides are tagged as surfaces 1..6 in the order
+// x = 0, x = max, y = 0, y = max, z = 0, z = max. Nodes, elements and boundary
+// faces are written as they are generated, so the mesh is never kept in memory
+class MeshGenerator {
+private:
+	array<unsigned int, COORDS_PER_NODE> m_cells;
+	array<double, COORDS_PER_NODE> m_size;
+
+private:
+	unsigned int getNodeId(unsigned int i, unsigned int j, unsigned int k) const;
+	void getNodeCoord(unsigned int id, array<double, COORDS_PER_NODE>* coord) const;
+	void getCellElements(unsigned int i, unsigned int j, unsigned int k,
+						 array<array<unsigned int, NODES_PER_ELEMENT>, TETRAHEDRONS_PER_CELL>* elements) const;
+	void getSideFaces(unsigned int side, unsigned int first, unsigned int second,
+					  vector<array<unsigned int, NODES_PER_EDGE>>* faces) const;
+	void getSideCells(unsigned int side, unsigned int* first_count, unsigned int* second_count) const;
+
+public:
+	MeshGenerator();
+	bool setCellCount(unsigned int x_cells, unsigned int y_cells, unsigned int z_cells);
+	bool setSize(double x_size, double y_size, double z_size);
+	unsigned long long getNodeCount() const;
+	unsigned long long getElementCount() const;
+	unsigned long long getBoundaryFaceCount() const;
+	bool writeNeutralFile(const string& file_path) const;
+	bool writeBinaryFile(const string& file_path) const;
+};
@@ -0,0 +1,104 @@
+// Mesh generator executable. Build it from MeshGenerator.cpp, FiniteElement.cpp,
+// MeshCache.cpp and MappedFile.cpp, for example
+// g++ -std=c++17 -O2 MeshGenerator_main.cpp MeshGenerator.cpp FiniteElement.cpp MeshCache.cpp MappedFile.cpp -o mesh_generator
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "MeshGenerator.h"
+
+using namespace std;
+
+bool readUnsignedArgument(const char* text, unsigned int* value) {
+	char* end;
+	unsigned long result;
+
+	if (*text == '\0' || *text == '-')
+		return false;
+
+	result = strtoul(text, &end, 10);
+	if (*end != '\0' || result > UINT32_MAX)
+		return false;
+
+	*value = static_cast<unsigned int>(result);
+	return true;
+}
+
+bool readDoubleArgument(const char* text, double* value) {
+	char* end;
+
+	if (*text == '\0')
+		return false;
+
+	*value = strtod(text, &end);
+	return *end == '\0';
+}
+
+int main(int argc, char* argv[]) {
+	MeshGenerator generator;
+	array<unsigned int, COORDS_PER_NODE> cells;
+	array<double, COORDS_PER_NODE> size = { 1., 1., 1. };
+	string argument, output_path;
+	bool is_binary = false;
+	bool is_written;
+
+	if (argc < 5) {
+		cout << "Usage: " << argv[0] << " <x cells> <y cells> <z cells> <output file> [--size X Y Z] [--binary]" << endl << endl
+			<< "Writes a box split into x * y * z cells with six tetrahedrons each. Box sides are the surfaces" << endl
+			<< "1..6: x = 0, x = max, y = 0, y = max, z = 0, z = max. The mesh is written in Neutral Format" << endl
+			<< "or, with --binary, in the binary mesh cache format which the solver opens directly." << endl;
+		return 1;
+	}
+
+	for (unsigned int i = 0; i < COORDS_PER_NODE; ++i)
+		if (!readUnsignedArgument(argv[i + 1], &cells[i])) {
+			cout << "Incorrect number of cells: " << argv[i + 1] << endl;
+			return 1;
+		}
+
+	output_path = argv[4];
+
+	for (int i = 5; i < argc; ++i) {
+		argument = argv[i];
+
+		if (argument == "--binary")
+			is_binary = true;
+
+		else if (argument == "--size" && i + COORDS_PER_NODE < argc) {
+			for (unsigned int j = 0; j < COORDS_PER_NODE; ++j)
+				if (!readDoubleArgument(argv[++i], &size[j])) {
+					cout << "Incorrect box size: " << argv[i] << endl;
+					return 1;
+				}
+		}
+
+		else {
+			cout << "Unknown option " << argument << endl;
+			return 1;
+		}
+	}
+
+	if (!generator.setCellCount(cells[0], cells[1], cells[2])) {
+		cout << "The mesh is empty or has too many nodes or elements" << endl;
+		return 1;
+	}
+
+	if (!generator.setSize(size[0], size[1], size[2])) {
+		cout << "Box size must be positive" << endl;
+		return 1;
+	}
+
+	cout << "Writing " << generator.getNodeCount() << " nodes, " << generator.getElementCount() << " elements and "
+		<< generator.getBoundaryFaceCount() << " boundary faces to " << output_path << "..." << endl;
+
+	if (is_binary)
+		is_written = generator.writeBinaryFile(output_path);
+	else
+		is_written = generator.writeNeutralFile(output_path);
+
+	if (!is_written) {
+		cout << "Can't write the mesh file " << output_path << endl;
+		return 2;
+	}
+
+	return 0;
+}
@@ -0,0 +1,299 @@
+#include "NodeOrdering.h"
+
+NodeOrdering::NodeOrdering() {
+}
+
+void NodeOrdering::initAdjacency(const DataLoader* data_loader) {
+	unsigned int number_of_nodes = data_loader->getNodeCount();
+	unsigned int number_of_elements = data_loader->getElementCount();
+	unsigned int current_node, row_begin, row_end, row_size;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	vector<unsigned int> row_fill;
+	vector<unsigned int> candidates;
+
+	m_adjacency_ptr.assign(number_of_nodes + 1, 0);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			m_adjacency_ptr[current_elem_nodes_id->at(k) + 1] += NODES_PER_ELEMENT - 1;
+	}
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i)
+		m_adjacency_ptr[i + 1] += m_adjacency_ptr[i];
+
+	candidates.resize(m_adjacency_ptr.back());
+	row_fill.assign(m_adjacency_ptr.begin(), m_adjacency_ptr.end() - 1);
+
+	for (unsigned int i = 0; i < number_of_elements; ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k) {
+			current_node = current_elem_nodes_id->at(k);
+			for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
+				if (l != k)
+					candidates[row_fill[current_node]++] = current_elem_nodes_id->at(l);
+		}
+	}
+
+	m_adjacency.clear();
+	m_adjacency.reserve(candidates.size() / 2);
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		row_begin = m_adjacency_ptr[i];
+		row_end = m_adjacency_ptr[i + 1];
+
+		sort(candidates.begin() + row_begin, candidates.begin() + row_end);
+		row_size = unique(candidates.begin() + row_begin, candidates.begin() + row_end) - candidates.begin() - row_begin;
+
+		m_adjacency_ptr[i] = m_adjacency.size();
+		m_adjacency.insert(m_adjacency.end(), candidates.begin() + row_begin, candidates.begin() + row_begin + row_size);
+	}
+
+	m_adjacency_ptr[number_of_nodes] = m_adjacency.size();
+}
+
+unsigned int NodeOrdering::getDegree(unsigned int node) const {
+	return m_adjacency_ptr[node + 1] - m_adjacency_ptr[node];
+}
+
+// Breadth-first search from the root. Returns the number of levels, the visited nodes stay in the queue
+// and their levels are reset to -1 by the caller
+unsigned int NodeOrdering::getLevelStructure(unsigned int root, vector<int>* levels, vector<unsigned int>* queue) const {
+	unsigned int current_node, neighbour;
+	int max_level = 0;
+
+	queue->clear();
+	queue->push_back(root);
+	levels->at(root) = 0;
+
+	for (unsigned int head = 0; head < queue->size(); ++head) {
+		current_node = queue->at(head);
+		max_level = levels->at(current_node);
+
+		for (unsigned int k = m_adjacency_ptr[current_node]; k < m_adjacency_ptr[current_node + 1]; ++k) {
+			neighbour = m_adjacency[k];
+			if (levels->at(neighbour) >= 0)
+				continue;
+
+			levels->at(neighbour) = max_level + 1;
+			queue->push_back(neighbour);
+		}
+	}
+
+	return max_level + 1;
+}
+
+// George-Liu search: move to a node of the last level with the smallest degree while the
+// number of levels grows. Such a start gives a long and narrow level structure
+unsigned int NodeOrdering::findPseudoPeripheralNode(unsigned int start, vector<int>* levels) const {
+	unsigned int root = start;
+	unsigned int number_of_levels, new_number_of_levels, candidate;
+	vector<unsigned int> queue;
+
+	number_of_levels = getLevelStructure(root, levels, &queue);
+
+	for (unsigned int i = 0; i < ORDERING_MAX_PERIPHERAL_SEARCHES; ++i) {
+		candidate = queue.back();
+		for (unsigned int k = queue.size(); k > 0 && levels->at(queue[k - 1]) == (int)number_of_levels - 1; --k)
+			if (getDegree(queue[k - 1]) < getDegree(candidate))
+				candidate = queue[k - 1];
+
+		for (unsigned int k = 0; k < queue.size(); ++k)
+			levels->at(queue[k]) = -1;
+
+		new_number_of_levels = getLevelStructure(candidate, levels, &queue);
+		if (new_number_of_levels <= number_of_levels) {
+			for (unsigned int k = 0; k < queue.size(); ++k)
+				levels->at(queue[k]) = -1;
+			return root;
+		}
+
+		root = candidate;
+		number_of_levels = new_number_of_levels;
+	}
+
+	for (unsigned int k = 0; k < queue.size(); ++k)
+		levels->at(queue[k]) = -1;
+
+	return root;
+}
+
+void NodeOrdering::initReverseCuthillMcKee(const DataLoader* data_loader) {
+	unsigned int number_of_nodes = data_loader->getNodeCount();
+	unsigned int current_node, neighbours_begin;
+	vector<int> levels(number_of_nodes, -1);
+	vector<bool> is_visited(number_of_nodes, false);
+	vector<unsigned int> order;
+
+	initAdjacency(data_loader);
+	order.reserve(number_of_nodes);
+
+	for (unsigned int start = 0; start < number_of_nodes; ++start) {
+		if (is_visited[start])
+			continue;
+
+		current_node = findPseudoPeripheralNode(start, &levels);
+		is_visited[current_node] = true;
+		order.push_back(current_node);
+
+		// Cuthill-McKee: the unvisited neighbours of every node are appended by increasing degree
+		for (unsigned int head = order.size() - 1; head < order.size(); ++head) {
+			current_node = order[head];
+			neighbours_begin = order.size();
+
+			for (unsigned int k = m_adjacency_ptr[current_node]; k < m_adjacency_ptr[current_node + 1]; ++k) {
+				if (is_visited[m_adjacency[k]])
+					continue;
+
+				is_visited[m_adjacency[k]] = true;
+				order.push_back(m_adjacency[k]);
+			}
+
+			stable_sort(order.begin() + neighbours_begin, order.end(), [this](unsigned int first, unsigned int second) {
+				return getDegree(first) < getDegree(second);
+			});
+		}
+	}
+
+	m_new_ids.resize(number_of_nodes);
+	for (unsigned int i = 0; i < number_of_nodes; ++i)
+		m_new_ids[order[i]] = number_of_nodes - 1 - i;
+
+	m_adjacency_ptr.clear();
+	m_adjacency.clear();
+}
+
+void NodeOrdering::initSpaceFillingCurve(const DataLoader* data_loader, NodeOrderingType type) {
+	unsigned int number_of_nodes = data_loader->getNodeCount();
+	double scale;
+	const array<double, COORDS_PER_NODE>* current_coord;
+	array<double, COORDS_PER_NODE> min_coord, max_coord;
+	array<uint32_t, COORDS_PER_NODE> grid_coord;
+	vector<uint64_t> keys(number_of_nodes);
+	vector<unsigned int> order(number_of_nodes);
+
+	min_coord.fill(DBL_MAX);
+	max_coord.fill(-DBL_MAX);
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		current_coord = data_loader->getNodeCoord(i);
+		for (unsigned int k = 0; k < COORDS_PER_NODE; ++k) {
+			min_coord[k] = min(min_coord[k], current_coord->at(k));
+			max_coord[k] = max(max_coord[k], current_coord->at(k));
+		}
+	}
+
+	// one scale for all axes keeps the cells of the curve cubic
+	scale = 0;
+	for (unsigned int k = 0; k < COORDS_PER_NODE; ++k)
+		scale = max(scale, max_coord[k] - min_coord[k]);
+	scale = scale > 0 ? ((1u << ORDERING_CURVE_BITS) - 1) / scale : 0;
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		current_coord = data_loader->getNodeCoord(i);
+		for (unsigned int k = 0; k < COORDS_PER_NODE; ++k)
+			grid_coord[k] = (uint32_t)((current_coord->at(k) - min_coord[k]) * scale);
+
+		keys[i] = type == HILBERT_ORDERING ? getHilbertKey(&grid_coord) : getMortonKey(&grid_coord);
+		order[i] = i;
+	}
+
+	stable_sort(order.begin(), order.end(), [&keys](unsigned int first, unsigned int second) {
+		return keys[first] < keys[second];
+	});
+
+	m_new_ids.resize(number_of_nodes);
+	for (unsigned int i = 0; i < number_of_nodes; ++i)
+		m_new_ids[order[i]] = i;
+}
+
+uint64_t NodeOrdering::getMortonKey(const array<uint32_t, COORDS_PER_NODE>* coords) {
+	uint64_t key = 0;
+
+	for (int bit = ORDERING_CURVE_BITS - 1; bit >= 0; --bit)
+		for (unsigned int k = 0; k < COORDS_PER_NODE; ++k)
+			key = (key << 1) | ((coords->at(k) >> bit) & 1);
+
+	return key;
+}
+
+// Skilling's transform of the coordinates into the transposed Hilbert index, then the bits are interleaved
+uint64_t NodeOrdering::getHilbertKey(const array<uint32_t, COORDS_PER_NODE>* coords) {
+	array<uint32_t, COORDS_PER_NODE> x = *coords;
+	uint32_t top = 1u << (ORDERING_CURVE_BITS - 1);
+	uint32_t mask, tmp;
+
+	for (uint32_t q = top; q > 1; q >>= 1) {
+		mask = q - 1;
+		for (unsigned int k = 0; k < COORDS_PER_NODE; ++k) {
+			if (x[k] & q)
+				x[0] ^= mask;
+			else {
+				tmp = (x[0] ^ x[k]) & mask;
+				x[0] ^= tmp;
+				x[k] ^= tmp;
+			}
+		}
+	}
+
+	for (unsigned int k = 1; k < COORDS_PER_NODE; ++k)
+		x[k] ^= x[k - 1];
+
+	tmp = 0;
+	for (uint32_t q = top; q > 1; q >>= 1)
+		if (x[COORDS_PER_NODE - 1] & q)
+			tmp ^= q - 1;
+
+	for (unsigned int k = 0; k < COORDS_PER_NODE; ++k)
+		x[k] ^= tmp;
+
+	return getMortonKey(&x);
+}
+
+void NodeOrdering::init(const DataLoader* data_loader, NodeOrderingType type) {
+	switch (type) {
+	case RCM_ORDERING:
+		initReverseCuthillMcKee(data_loader);
+		break;
+	case HILBERT_ORDERING:
+	case MORTON_ORDERING:
+		initSpaceFillingCurve(data_loader, type);
+		break;
+	default:
+		m_new_ids.resize(data_loader->getNodeCount());
+		for (unsigned int i = 0; i < m_new_ids.size(); ++i)
+			m_new_ids[i] = i;
+		break;
+	}
+}
+
+const vector<unsigned int>* NodeOrdering::getNewIds() const {
+	return &m_new_ids;
+}
+
+// Bandwidth and profile of the lower triangle of the global matrix for the current numbering
+void NodeOrdering::getEnvelope(const DataLoader* data_loader, unsigned int* bandwidth, unsigned long long* profile) {
+	unsigned int number_of_nodes = data_loader->getNodeCount();
+	unsigned int elem_min;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	vector<unsigned int> row_min(number_of_nodes);
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i)
+		row_min[i] = i;
+
+	for (unsigned int i = 0; i < data_loader->getElementCount(); ++i) {
+		current_elem_nodes_id = data_loader->getElement(i)->getNodesId();
+		elem_min = *min_element(current_elem_nodes_id->begin(), current_elem_nodes_id->end());
+
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			row_min[current_elem_nodes_id->at(k)] = min(row_min[current_elem_nodes_id->at(k)], elem_min);
+	}
+
+	*bandwidth = 0;
+	*profile = 0;
+
+	for (unsigned int i = 0; i < number_of_nodes; ++i) {
+		*bandwidth = max(*bandwidth, i - row_min[i]);
+		*profile += i - row_min[i];
+	}
+}
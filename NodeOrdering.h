@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "DataLoader.h"
+#include "Defines.h"
+
+using namespace std;
+
+#define ORDERING_CURVE_BITS 21
+#define ORDERING_MAX_PERIPHERAL_SEARCHES 8
+
+enum NodeOrderingType {
+	NO_ORDERING,
+	RCM_ORDERING,
+	HILBERT_ORDERING,
+	MORTON_ORDERING,
+};
+
+// New node numbering that brings nodes of neighbouring elements close together:
+// reverse Cuthill-McKee on the node graph or a space-filling curve through the node coordinates
+class NodeOrdering {
+private:
+	vector<unsigned int> m_new_ids;
+	vector<unsigned int> m_adjacency_ptr;
+	vector<unsigned int> m_adjacency;
+
+private:
+	void initAdjacency(const DataLoader* data_loader);
+	unsigned int getDegree(unsigned int node) const;
+	unsigned int findPseudoPeripheralNode(unsigned int start, vector<int>* levels) const;
+	unsigned int getLevelStructure(unsigned int root, vector<int>* levels, vector<unsigned int>* queue) const;
+	void initReverseCuthillMcKee(const DataLoader* data_loader);
+	void initSpaceFillingCurve(const DataLoader* data_loader, NodeOrderingType type);
+	static uint64_t getMortonKey(const array<uint32_t, COORDS_PER_NODE>* coords);
+	static uint64_t getHilbertKey(const array<uint32_t, COORDS_PER_NODE>* coords);
+
+public:
+	NodeOrdering();
+	void init(const DataLoader* data_loader, NodeOrderingType type);
+	const vector<unsigned int>* getNewIds() const;
+	static void getEnvelope(const DataLoader* data_loader, unsigned int* bandwidth, unsigned long long* profile);
+};
@@ -0,0 +1,88 @@
+#include "Parallel.h"
+
+// set in the pool workers, a parallel loop started inside a task runs on its own thread
+static thread_local bool is_pool_worker = false;
+
+unsigned int getDefaultThreadCount() {
+	unsigned int number_of_threads = thread::hardware_concurrency();
+
+	if (number_of_threads == 0)
+		return 1;
+
+	return number_of_threads;
+}
+
+ThreadPool::ThreadPool() :
+	m_task(nullptr), m_number_of_tasks(0), m_pending_tasks(0), m_generation(0), m_is_stopping(false) {
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_is_stopping = true;
+	}
+	m_task_ready.notify_all();
+
+	for (unsigned int i = 0; i < m_workers.size(); ++i)
+		m_workers.at(i).join();
+}
+
+ThreadPool* ThreadPool::getInstance() {
+	static ThreadPool thread_pool;
+	return &thread_pool;
+}
+
+// A nested run or a run from a second thread while the pool is busy executes the tasks in order on the
+// calling thread. The chunks are the same, so the results do not depend on where the tasks ran
+void ThreadPool::run(unsigned int number_of_tasks, const function<void(unsigned int)>* task) {
+	unique_lock<mutex> run_lock(m_run_mutex, try_to_lock);
+
+	if (is_pool_worker || !run_lock.owns_lock()) {
+		for (unsigned int i = 0; i < number_of_tasks; ++i)
+			(*task)(i);
+		return;
+	}
+
+	// a new worker starts at the current generation, so it takes the run below and not an older one
+	while (m_workers.size() + 1 < number_of_tasks)
+		m_workers.push_back(thread(&ThreadPool::workerLoop, this, m_workers.size() + 1, m_generation));
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_task = task;
+		m_number_of_tasks = number_of_tasks;
+		m_pending_tasks = number_of_tasks - 1;
+		++m_generation;
+	}
+	m_task_ready.notify_all();
+
+	(*task)(0);
+
+	unique_lock<mutex> lock(m_mutex);
+	m_task_done.wait(lock, [this]() { return m_pending_tasks == 0; });
+}
+
+void ThreadPool::workerLoop(unsigned int worker_id, unsigned int generation) {
+	const function<void(unsigned int)>* task;
+	unique_lock<mutex> lock(m_mutex);
+
+	is_pool_worker = true;
+
+	while (true) {
+		m_task_ready.wait(lock, [&]() { return m_is_stopping || m_generation != generation; });
+		if (m_is_stopping)
+			return;
+
+		generation = m_generation;
+		if (worker_id >= m_number_of_tasks)
+			continue;
+
+		task = m_task;
+		lock.unlock();
+		(*task)(worker_id);
+		lock.lock();
+
+		if (--m_pending_tasks == 0)
+			m_task_done.notify_one();
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+unsigned int getDefaultThreadCount();
+
+// Workers are started on first use and kept until the program exits, so a parallel loop
+// costs a wake-up instead of a thread start. Task 0 of every run is executed by the caller
+class ThreadPool {
+private:
+	vector<thread> m_workers;
+	mutex m_run_mutex;
+	mutex m_mutex;
+	condition_variable m_task_ready;
+	condition_variable m_task_done;
+	const function<void(unsigned int)>* m_task;
+	unsigned int m_number_of_tasks;
+	unsigned int m_pending_tasks;
+	unsigned int m_generation;
+	bool m_is_stopping;
+
+private:
+	ThreadPool();
+	void workerLoop(unsigned int worker_id, unsigned int generation);
+
+public:
+	~ThreadPool();
+	static ThreadPool* getInstance();
+	void run(unsigned int number_of_tasks, const function<void(unsigned int)>* task);
+};
+
+// Splits [begin, end) into one contiguous chunk per thread and calls
+// function(thread_id, chunk_begin, chunk_end) for every chunk. The calling thread
+// processes the first chunk itself
+template <typename Function>
+void parallelFor(unsigned int begin, unsigned int end, unsigned int number_of_threads, Function function) {
+	unsigned int size = end > begin ? end - begin : 0;
+	unsigned int chunk_size;
+
+	if (number_of_threads > size)
+		number_of_threads = size;
+
+	if (number_of_threads <= 1) {
+		if (size != 0)
+			function(0u, begin, end);
+		return;
+	}
+
+	chunk_size = (size + number_of_threads - 1) / number_of_threads;
+
+	const std::function<void(unsigned int)> task = [&](unsigned int i) {
+		function(i, begin + i * chunk_size, min(end, begin + (i + 1) * chunk_size));
+	};
+
+	ThreadPool::getInstance()->run((size + chunk_size - 1) / chunk_size, &task);
+}
@@ -0,0 +1,63 @@
+#include "PcgSolver.h"
+
+PcgSolver::PcgSolver() :
+	m_tolerance(DEFAULT_PCG_TOLERANCE), m_max_iterations(DEFAULT_PCG_MAX_ITERATIONS), m_number_of_threads(1), m_iteration_count(0), m_residual(0) {
+}
+
+void PcgSolver::setTolerance(double tolerance) {
+	m_tolerance = tolerance;
+}
+
+void PcgSolver::setMaxIterations(unsigned int max_iterations) {
+	m_max_iterations = max_iterations;
+}
+
+void PcgSolver::setThreadCount(unsigned int number_of_threads) {
+	m_number_of_threads = number_of_threads;
+}
+
+bool PcgSolver::solve(const LinearOperator* matrix, const Preconditioner* preconditioner, const Eigen::VectorXd* rhs, Eigen::VectorXd* result) {
+	Eigen::VectorXd residual, preconditioned, direction, matrix_by_direction;
+	double rhs_norm = rhs->norm();
+	double residual_by_preconditioned, new_residual_by_preconditioned, alpha;
+
+	m_iteration_count = 0;
+	m_residual = 0;
+	result->setZero(rhs->size());
+
+	if (rhs_norm == 0)
+		return true;
+
+	residual = *rhs;
+	preconditioner->apply(&residual, &preconditioned);
+	direction = preconditioned;
+	residual_by_preconditioned = residual.dot(preconditioned);
+
+	while (m_iteration_count < m_max_iterations) {
+		matrix->multiply(&direction, &matrix_by_direction, m_number_of_threads);
+		alpha = residual_by_preconditioned / direction.dot(matrix_by_direction);
+
+		*result += alpha * direction;
+		residual -= alpha * matrix_by_direction;
+		++m_iteration_count;
+
+		m_residual = residual.norm() / rhs_norm;
+		if (m_residual <= m_tolerance)
+			return true;
+
+		preconditioner->apply(&residual, &preconditioned);
+		new_residual_by_preconditioned = residual.dot(preconditioned);
+		direction = preconditioned + (new_residual_by_preconditioned / residual_by_preconditioned) * direction;
+		residual_by_preconditioned = new_residual_by_preconditioned;
+	}
+
+	return false;
+}
+
+unsigned int PcgSolver::getIterationCount() const {
+	return m_iteration_count;
+}
+
+double PcgSolver::getResidual() const {
+	return m_residual;
+}
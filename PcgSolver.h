@@ -0,0 +1,26 @@
+#pragma once
+#include <cmath>
+#include "./lib/eigen/Dense"
+#include "CsrMatrix.h"
+#include "Preconditioner.h"
+#include "Defines.h"
+
+using namespace std;
+
+class PcgSolver {
+private:
+	double m_tolerance;
+	unsigned int m_max_iterations;
+	unsigned int m_number_of_threads;
+	unsigned int m_iteration_count;
+	double m_residual;
+
+public:
+	PcgSolver();
+	void setTolerance(double tolerance);
+	void setMaxIterations(unsigned int max_iterations);
+	void setThreadCount(unsigned int number_of_threads);
+	bool solve(const LinearOperator* matrix, const Preconditioner* preconditioner, const Eigen::VectorXd* rhs, Eigen::VectorXd* result);
+	unsigned int getIterationCount() const;
+	double getResidual() const;
+};
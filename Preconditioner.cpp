@@ -0,0 +1,177 @@
+#include "Preconditioner.h"
+
+Preconditioner::~Preconditioner() {
+}
+
+bool JacobiPreconditioner::init(const CsrMatrix* matrix) {
+	Eigen::VectorXd diagonal;
+
+	matrix->getDiagonal(&diagonal);
+	return initDiagonal(&diagonal);
+}
+
+bool JacobiPreconditioner::initDiagonal(const Eigen::VectorXd* diagonal) {
+	m_inverse_diagonal = *diagonal;
+
+	for (unsigned int i = 0; i < m_inverse_diagonal.size(); ++i) {
+		if (m_inverse_diagonal(i) == 0)
+			return false;
+		m_inverse_diagonal(i) = 1. / m_inverse_diagonal(i);
+	}
+
+	return true;
+}
+
+void JacobiPreconditioner::apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const {
+	*result = residual->cwiseProduct(m_inverse_diagonal);
+}
+
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner() : m_number_of_rows(0) {
+}
+
+bool IncompleteCholeskyPreconditioner::factorize(const CsrMatrix* matrix, double shift) {
+	const vector<int>* row_ptr = matrix->getRowPtr();
+	const vector<int>* col_ids = matrix->getColIds();
+	const vector<double>* values = matrix->getValues();
+	vector<int> position(m_number_of_rows, -1);
+	unsigned int current_col;
+	double accumulator;
+
+	m_row_ptr.assign(1, 0);
+	m_col_ids.clear();
+	m_values.clear();
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1) && col_ids->at(k) <= static_cast<int>(i); ++k) {
+			current_col = col_ids->at(k);
+			position[current_col] = m_col_ids.size();
+			m_col_ids.push_back(current_col);
+			m_values.push_back(values->at(k));
+		}
+
+		if (m_col_ids.empty() || m_col_ids.back() != static_cast<int>(i))
+			return false;
+
+		m_values.back() *= 1. + shift;
+
+		// row i of L only uses the pattern of row i of A, so the products with the
+		// already factorized rows are taken where both patterns meet
+		for (int k = m_row_ptr[i]; k < static_cast<int>(m_col_ids.size()) - 1; ++k) {
+			current_col = m_col_ids[k];
+			accumulator = m_values[k];
+
+			for (int l = m_row_ptr[current_col]; l < m_row_ptr[current_col + 1] - 1; ++l)
+				if (position[m_col_ids[l]] >= 0)
+					accumulator -= m_values[position[m_col_ids[l]]] * m_values[l];
+
+			m_values[k] = accumulator / m_values[m_row_ptr[current_col + 1] - 1];
+		}
+
+		accumulator = m_values.back();
+		for (int k = m_row_ptr[i]; k < static_cast<int>(m_col_ids.size()) - 1; ++k)
+			accumulator -= m_values[k] * m_values[k];
+
+		if (accumulator <= 0)
+			return false;
+
+		m_values.back() = sqrt(accumulator);
+
+		for (int k = m_row_ptr[i]; k < static_cast<int>(m_col_ids.size()); ++k)
+			position[m_col_ids[k]] = -1;
+
+		m_row_ptr.push_back(m_col_ids.size());
+	}
+
+	return true;
+}
+
+bool IncompleteCholeskyPreconditioner::init(const CsrMatrix* matrix) {
+	double shift = 0;
+
+	m_number_of_rows = matrix->getRowCount();
+
+	while (!factorize(matrix, shift)) {
+		shift = shift == 0 ? 1e-3 : shift * 2;
+		if (shift > 1e3)
+			return false;
+		cout << "Incomplete Cholesky breakdown, retrying with diagonal shift " << shift << endl << endl;
+	}
+
+	return true;
+}
+
+void IncompleteCholeskyPreconditioner::apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const {
+	double accumulator;
+
+	*result = *residual;
+
+	for (unsigned int i = 0; i < m_number_of_rows; ++i) {
+		accumulator = (*result)(i);
+		for (int k = m_row_ptr[i]; k < m_row_ptr[i + 1] - 1; ++k)
+			accumulator -= m_values[k] * (*result)(m_col_ids[k]);
+		(*result)(i) = accumulator / m_values[m_row_ptr[i + 1] - 1];
+	}
+
+	for (unsigned int i = m_number_of_rows; i > 0; --i) {
+		(*result)(i - 1) /= m_values[m_row_ptr[i] - 1];
+		for (int k = m_row_ptr[i - 1]; k < m_row_ptr[i] - 1; ++k)
+			(*result)(m_col_ids[k]) -= m_values[k] * (*result)(i - 1);
+	}
+}
+
+SsorPreconditioner::SsorPreconditioner() : m_relaxation(1.), m_matrix(nullptr) {
+}
+
+void SsorPreconditioner::setRelaxation(double relaxation) {
+	m_relaxation = relaxation;
+}
+
+bool SsorPreconditioner::init(const CsrMatrix* matrix) {
+	m_matrix = matrix;
+	matrix->getDiagonal(&m_diagonal);
+
+	if (m_relaxation <= 0 || m_relaxation >= 2)
+		return false;
+
+	for (unsigned int i = 0; i < m_diagonal.size(); ++i)
+		if (m_diagonal(i) <= 0)
+			return false;
+
+	return true;
+}
+
+void SsorPreconditioner::apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const {
+	const vector<int>* row_ptr = m_matrix->getRowPtr();
+	const vector<int>* col_ids = m_matrix->getColIds();
+	const vector<double>* values = m_matrix->getValues();
+	unsigned int number_of_rows = m_matrix->getRowCount();
+	int current_col;
+	double accumulator;
+
+	// M = (D + wL) D^-1 (D + wU) / (w (2 - w))
+	*result = *residual * (m_relaxation * (2. - m_relaxation));
+
+	for (unsigned int i = 0; i < number_of_rows; ++i) {
+		accumulator = (*result)(i);
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+			current_col = col_ids->at(k);
+			if (current_col >= static_cast<int>(i))
+				break;
+			accumulator -= m_relaxation * values->at(k) * (*result)(current_col);
+		}
+		(*result)(i) = accumulator / m_diagonal(i);
+	}
+
+	*result = result->cwiseProduct(m_diagonal);
+
+	for (unsigned int i = number_of_rows; i > 0; --i) {
+		accumulator = (*result)(i - 1);
+		for (int k = row_ptr->at(i) - 1; k >= row_ptr->at(i - 1); --k) {
+			current_col = col_ids->at(k);
+			if (current_col <= static_cast<int>(i - 1))
+				break;
+			accumulator -= m_relaxation * values->at(k) * (*result)(current_col);
+		}
+		(*result)(i - 1) = accumulator / m_diagonal(i - 1);
+	}
+}
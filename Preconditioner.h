@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include "./lib/eigen/Dense"
+#include "CsrMatrix.h"
+#include "Defines.h"
+
+using namespace std;
+
+enum PreconditionerType {
+	JACOBI_PRECONDITIONER,
+	INCOMPLETE_CHOLESKY_PRECONDITIONER,
+	SSOR_PRECONDITIONER,
+	AMG_PRECONDITIONER,
+};
+
+class Preconditioner {
+public:
+	virtual ~Preconditioner();
+	virtual bool init(const CsrMatrix* matrix) = 0;
+	virtual void apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const = 0;
+};
+
+class JacobiPreconditioner : public Preconditioner {
+private:
+	Eigen::VectorXd m_inverse_diagonal;
+
+public:
+	bool init(const CsrMatrix* matrix) override;
+	bool initDiagonal(const Eigen::VectorXd* diagonal);
+	void apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const override;
+};
+
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+private:
+	unsigned int m_number_of_rows;
+	vector<int> m_row_ptr;
+	vector<int> m_col_ids;
+	vector<double> m_values;
+
+private:
+	bool factorize(const CsrMatrix* matrix, double shift);
+
+public:
+	IncompleteCholeskyPreconditioner();
+	bool init(const CsrMatrix* matrix) override;
+	void apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const override;
+};
+
+class SsorPreconditioner : public Preconditioner {
+private:
+	double m_relaxation;
+	const CsrMatrix* m_matrix;
+	Eigen::VectorXd m_diagonal;
+
+public:
+	SsorPreconditioner();
+	void setRelaxation(double relaxation);
+	bool init(const CsrMatrix* matrix) override;
+	void apply(const Eigen::VectorXd* residual, Eigen::VectorXd* result) const override;
+};
@@ -0,0 +1,282 @@
+#include "Profiler.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+static atomic<unsigned long long> total_allocations(0);
+static atomic<unsigned long long> total_allocated_bytes(0);
+
+#if PROFILER_COUNT_ALLOCATIONS
+void* operator new(size_t size) {
+	void* pointer;
+
+	total_allocations.fetch_add(1, memory_order_relaxed);
+	total_allocated_bytes.fetch_add(size, memory_order_relaxed);
+
+	pointer = malloc(size == 0 ? 1 : size);
+	if (pointer == nullptr)
+		throw bad_alloc();
+
+	return pointer;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+	free(pointer);
+}
+#endif
+
+Profiler::Profiler() : m_start_time(chrono::steady_clock::now()) {
+}
+
+void Profiler::takeSample(ProfilerSample* sample) const {
+	sample->wall_time = chrono::duration<double>(chrono::steady_clock::now() - m_start_time).count();
+	sample->cpu_time = getCpuTime();
+	sample->peak_memory = getPeakMemory();
+	sample->allocations = getAllocationCount();
+	sample->allocated_bytes = getAllocatedBytes();
+}
+
+void Profiler::beginPhase(const string& name) {
+	ProfilerPhase phase;
+
+	phase.name = name;
+	phase.depth = m_open_phases.size();
+	takeSample(&phase.begin);
+	phase.end = phase.begin;
+
+	m_open_phases.push_back(m_phases.size());
+	m_phases.push_back(phase);
+}
+
+void Profiler::endPhase() {
+	if (m_open_phases.empty())
+		return;
+
+	takeSample(&m_phases.at(m_open_phases.back()).end);
+	m_open_phases.pop_back();
+}
+
+void Profiler::setCounter(const string& name, double value) {
+	for (unsigned int i = 0; i < m_counters.size(); ++i)
+		if (m_counters.at(i).first == name) {
+			m_counters.at(i).second = value;
+			return;
+		}
+
+	m_counters.push_back(pair<string, double>(name, value));
+}
+
+unsigned int Profiler::getPhaseCount() const {
+	return m_phases.size();
+}
+
+const ProfilerPhase* Profiler::getPhase(unsigned int id) const {
+	return &(m_phases.at(id));
+}
+
+// Without the counting operator new the allocation fields are null, a zero would look like a measured value
+void Profiler::writeAllocationCount(ofstream* file, unsigned long long value) {
+	if (isCountingAllocations())
+		*file << value;
+	else
+		*file << "null";
+}
+
+void Profiler::writeString(ofstream* file, const string& value) {
+	*file << '"';
+
+	for (unsigned int i = 0; i < value.size(); ++i) {
+		if (value[i] == '"' || value[i] == '\\')
+			*file << '\\';
+		*file << value[i];
+	}
+
+	*file << '"';
+}
+
+bool Profiler::writeReport(const string& file_path) const {
+	ofstream file;
+	const ProfilerPhase* current_phase;
+
+	file.open(file_path);
+	if (!file.is_open()) {
+		cout << "Can't write profile report " << file_path << endl << endl;
+		return false;
+	}
+
+	file << setprecision(10);
+	file << "{" << endl << "\t\"phases\": [" << endl;
+
+	for (unsigned int i = 0; i < m_phases.size(); ++i) {
+		current_phase = &m_phases.at(i);
+
+		file << "\t\t{ \"name\": ";
+		writeString(&file, current_phase->name);
+		file << ", \"depth\": " << current_phase->depth
+			<< ", \"start_ms\": " << current_phase->begin.wall_time * 1000
+			<< ", \"wall_ms\": " << (current_phase->end.wall_time - current_phase->begin.wall_time) * 1000
+			<< ", \"cpu_ms\": " << (current_phase->end.cpu_time - current_phase->begin.cpu_time) * 1000
+			<< ", \"peak_rss_bytes\": " << current_phase->end.peak_memory
+			<< ", \"allocations\": ";
+		writeAllocationCount(&file, current_phase->end.allocations - current_phase->begin.allocations);
+		file << ", \"allocated_bytes\": ";
+		writeAllocationCount(&file, current_phase->end.allocated_bytes - current_phase->begin.allocated_bytes);
+		file << " }" << (i + 1 < m_phases.size() ? "," : "") << endl;
+	}
+
+	file << "\t]," << endl << "\t\"counters\": {" << endl;
+
+	for (unsigned int i = 0; i < m_counters.size(); ++i) {
+		file << "\t\t";
+		writeString(&file, m_counters.at(i).first);
+		file << ": " << m_counters.at(i).second << (i + 1 < m_counters.size() ? "," : "") << endl;
+	}
+
+	file << "\t}," << endl
+		<< "\t\"peak_rss_bytes\": " << getPeakMemory() << "," << endl
+		<< "\t\"allocations_counted\": " << (isCountingAllocations() ? "true" : "false") << "," << endl
+		<< "\t\"allocations\": ";
+	writeAllocationCount(&file, getAllocationCount());
+	file << "," << endl << "\t\"allocated_bytes\": ";
+	writeAllocationCount(&file, getAllocatedBytes());
+	file << endl << "}" << endl;
+
+	return !file.fail();
+}
+
+bool Profiler::writeChromeTrace(const string& file_path) const {
+	ofstream file;
+	const ProfilerPhase* current_phase;
+	double end_time = 0;
+
+	file.open(file_path);
+	if (!file.is_open()) {
+		cout << "Can't write profile trace " << file_path << endl << endl;
+		return false;
+	}
+
+	// complete events in microseconds, see the Trace Event Format used by chrome://tracing and Perfetto
+	file << setprecision(15);
+	file << "{ \"displayTimeUnit\": \"ms\", \"otherData\": { \"allocations_counted\": "
+		<< (isCountingAllocations() ? "true" : "false") << " }, \"traceEvents\": [" << endl;
+
+	for (unsigned int i = 0; i < m_phases.size(); ++i) {
+		current_phase = &m_phases.at(i);
+		end_time = max(end_time, current_phase->end.wall_time);
+
+		file << "\t{ \"name\": ";
+		writeString(&file, current_phase->name);
+		file << ", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+			<< ", \"ts\": " << current_phase->begin.wall_time * 1e6
+			<< ", \"dur\": " << (current_phase->end.wall_time - current_phase->begin.wall_time) * 1e6
+			<< ", \"args\": { \"cpu_ms\": " << (current_phase->end.cpu_time - current_phase->begin.cpu_time) * 1000
+			<< ", \"peak_rss_bytes\": " << current_phase->end.peak_memory
+			<< ", \"allocations\": ";
+		writeAllocationCount(&file, current_phase->end.allocations - current_phase->begin.allocations);
+		file << " } }," << endl;
+	}
+
+	for (unsigned int i = 0; i < m_counters.size(); ++i) {
+		file << "\t{ \"name\": ";
+		writeString(&file, m_counters.at(i).first);
+		file << ", \"ph\": \"C\", \"pid\": 1, \"ts\": " << end_time * 1e6
+			<< ", \"args\": { \"value\": " << m_counters.at(i).second << " } }"
+			<< (i + 1 < m_counters.size() ? "," : "") << endl;
+	}
+
+	file << "] }" << endl;
+
+	return !file.fail();
+}
+
+#ifdef _WIN32
+double Profiler::getCpuTime() {
+	FILETIME creation_time, exit_time, kernel_time, user_time;
+	ULARGE_INTEGER kernel, user;
+
+	if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+		return 0;
+
+	kernel.LowPart = kernel_time.dwLowDateTime;
+	kernel.HighPart = kernel_time.dwHighDateTime;
+	user.LowPart = user_time.dwLowDateTime;
+	user.HighPart = user_time.dwHighDateTime;
+
+	return (kernel.QuadPart + user.QuadPart) * 1e-7;
+}
+
+unsigned long long Profiler::getPeakMemory() {
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+
+	return counters.PeakWorkingSetSize;
+}
+#else
+double Profiler::getCpuTime() {
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+unsigned long long Profiler::getPeakMemory() {
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#ifdef __APPLE__
+	return usage.ru_maxrss;
+#else
+	return usage.ru_maxrss * 1024ull;
+#endif
+}
+#endif
+
+bool Profiler::isCountingAllocations() {
+	return PROFILER_COUNT_ALLOCATIONS != 0;
+}
+
+unsigned long long Profiler::getAllocationCount() {
+	return total_allocations.load(memory_order_relaxed);
+}
+
+unsigned long long Profiler::getAllocatedBytes() {
+	return total_allocated_bytes.load(memory_order_relaxed);
+}
+
+ProfilerScope::ProfilerScope(Profiler* profiler, const string& name) : m_profiler(profiler) {
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase(name);
+}
+
+ProfilerScope::~ProfilerScope() {
+	if (m_profiler != nullptr)
+		m_profiler->endPhase();
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include "Defines.h"
+
+using namespace std;
+
+struct ProfilerSample {
+	double wall_time;
+	double cpu_time;
+	unsigned long long peak_memory;
+	unsigned long long allocations;
+	unsigned long long allocated_bytes;
+};
+
+struct ProfilerPhase {
+	string name;
+	unsigned int depth;
+	ProfilerSample begin;
+	ProfilerSample end;
+};
+
+// Records nested phases of the program run and named counters. Every phase keeps
+// wall and CPU time, the peak resident set size at its end and the number of
+// operator new calls made inside it, which is counted only with PROFILER_COUNT_ALLOCATIONS.
+// Phases must be opened and closed by one thread
+class Profiler {
+private:
+	chrono::steady_clock::time_point m_start_time;
+	vector<ProfilerPhase> m_phases;
+	vector<unsigned int> m_open_phases;
+	vector<pair<string, double>> m_counters;
+
+private:
+	void takeSample(ProfilerSample* sample) const;
+	static void writeAllocationCount(ofstream* file, unsigned long long value);
+	static void writeString(ofstream* file, const string& value);
+
+public:
+	Profiler();
+	void beginPhase(const string& name);
+	void endPhase();
+	void setCounter(const string& name, double value);
+	unsigned int getPhaseCount() const;
+	const ProfilerPhase* getPhase(unsigned int id) const;
+	bool writeReport(const string& file_path) const;
+	bool writeChromeTrace(const string& file_path) const;
+
+public:
+	static double getCpuTime();
+	static unsigned long long getPeakMemory();
+	static bool isCountingAllocations();
+	static unsigned long long getAllocationCount();
+	static unsigned long long getAllocatedBytes();
+};
+
+// Opens a phase for the lifetime of the object, does nothing without a profiler
+class ProfilerScope {
+private:
+	Profiler* m_profiler;
+
+public:
+	ProfilerScope(Profiler* profiler, const string& name);
+	~ProfilerScope();
+	ProfilerScope(const ProfilerScope&) = delete;
+	ProfilerScope& operator=(const ProfilerScope&) = delete;
+};
@@ -1,423 +1,1391 @@
-#include "Solver.h"
-
-Solver::Solver(const DataLoader* data_loader) :
-	m_data_loader(data_loader), m_number_of_nodes(data_loader->getNodeCount()), m_max_temperature(DBL_MIN), m_min_temperature(DBL_MAX) {
-}
-
-void Solver::initLocalVector(array<double, NODES_PER_ELEMENT>* local_vector) const {
-	local_vector->fill(0.);
-}
-
-void Solver::applyConstantTempCond(const map<unsigned int, double>* nodes_with_const_temp) {
-	double temperature, tmp_value;
-	unsigned int  current_i, current_j;
-	map<pair<unsigned int, unsigned int >, double>::const_iterator global_matrix_iter;
-	map<unsigned int, double>::const_iterator find_i_iter, find_j_iter;
-	map<unsigned int, double>::const_iterator tmp_iter;
-	map<unsigned int, double>::const_iterator nodes_with_const_temp_end = nodes_with_const_temp->end();
-
-	for (global_matrix_iter = m_global_matrix.begin(); global_matrix_iter != m_global_matrix.end(); ++global_matrix_iter) {
-		current_i = global_matrix_iter->first.first;
-		current_j = global_matrix_iter->first.second;
-
-		find_i_iter = nodes_with_const_temp->find(current_i);
-		find_j_iter = nodes_with_const_temp->find(current_j);
-
-		if (find_i_iter != nodes_with_const_temp_end && current_j != current_i) {
-			global_matrix_iter = m_global_matrix.erase(global_matrix_iter);
-			global_matrix_iter--;
-			continue;
-		}
-
-		if (find_j_iter != nodes_with_const_temp_end && current_i != current_j) {
-			temperature = find_j_iter->second;
-			tmp_value = global_matrix_iter->second;
-			addToGlobalVector(current_i, -tmp_value * temperature);
-			global_matrix_iter = m_global_matrix.erase(global_matrix_iter);
-			global_matrix_iter--;
-			continue;
-		}
-
-		if (find_i_iter != nodes_with_const_temp_end && current_i == current_j) {
-			tmp_value = global_matrix_iter->second;
-			temperature = find_i_iter->second;
-			setToGlobalVector(current_i, tmp_value * temperature);
-			continue;
-		}
-	}
-}
-
-bool Solver::setGlobalArrays() {
-	unsigned int  number_of_elements = m_data_loader->getElementCount();
-	double heat_conduction_coeff = m_data_loader->getHeatConductionCoeff();
-	double temperature;
-	unsigned int  current_surface_id;
-	const Edge* current_edge;
-	const FiniteElement* current_elem;
-	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
-	array<const Edge*, NODES_PER_ELEMENT> current_elem_boundary_edges;
-	array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT> local_matrix;
-	array<double, NODES_PER_ELEMENT> local_vector;
-	array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT> local_numeration;
-	map<unsigned int, double> nodes_with_const_temp;
-	const array<unsigned int, 3>* current_edge_nodes_ids;
-	Condition* current_condition;
-	ConditionType current_condition_type;
-	const Surface* current_surface;
-
-	setupLocalNumeration(&local_numeration);
-
-	cout << "Calculating global marix and global vector..." << endl << endl;
-
-	for (unsigned int i = 0; i < number_of_elements; ++i) {
-		current_elem = m_data_loader->getElement(i);
-		current_elem_nodes_id = current_elem->getNodesId();
-
-		setupBoundaryEdges(&local_numeration, current_elem_nodes_id, &current_elem_boundary_edges);
-
-		initLocalMatrix(&local_matrix, current_elem, heat_conduction_coeff);
-
-		for (unsigned int j = 0; j < EDGES_PER_ELEMENT; ++j) {
-			if (current_elem_boundary_edges.at(j) == nullptr)
-				continue;
-
-			current_edge = current_elem_boundary_edges.at(j);
-			current_surface_id = current_edge->getSurfaceId();
-			current_surface = m_data_loader->getSurface(current_surface_id);
-			current_condition = current_surface->getCondition();
-			current_condition_type = current_condition->getType();
-
-			initLocalVector(&local_vector);
-
-			switch (current_condition_type) {
-			case CONSTANT_TEMPERATURE:
-				temperature = static_cast<ConstantTempCondition*>(current_condition)->getTemperature();
-				current_edge_nodes_ids = current_edge->getRightIdsOrder();
-				nodes_with_const_temp[current_edge_nodes_ids->at(0)] = temperature;
-				nodes_with_const_temp[current_edge_nodes_ids->at(1)] = temperature;
-				nodes_with_const_temp[current_edge_nodes_ids->at(2)] = temperature;
-				break;
-			case NO_HEAT_EXCHANGE:
-				break;
-			case HEAT_FLOW:
-				heatFlowCond(&local_vector, &local_numeration.at(j), current_elem, current_edge,
-					static_cast<HeatFlowCondition*>(current_condition));
-				break;
-			case ENVIRONMENT_HEAT_EXCHANGE:
-				envirinmentHeatExchangeCond(&local_matrix, &local_vector, &local_numeration.at(j), current_elem, current_edge,
-					static_cast<EnvironmentHeatExchangeCondition*>(current_condition));
-				break;
-			default:
-				cout << "Error while constructing global arrays. Unknown boundary condition type!" << endl;
-				return false;
-				break;
-			}
-
-			for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
-				addToGlobalVector(current_elem_nodes_id->at(k), local_vector[k]);
-		}
-
-		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
-			for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
-				addToGlobalMatrix(current_elem_nodes_id->at(k), current_elem_nodes_id->at(l), local_matrix.at(k).at(l));
-	}
-
-	if (nodes_with_const_temp.size() != 0) {
-		cout << "Applying constant temperature conditions..." << endl << endl;
-		applyConstantTempCond(&nodes_with_const_temp);
-	}
-
-	cout << "Global matrix and global vector are done. Global matrix consists of zeros at " <<
-		100 - (double)m_global_matrix.size() / ((double)m_number_of_nodes * (double)m_number_of_nodes) * 100 << " persent" << endl << endl;
-
-	return true;
-}
-
-bool Solver::solve() {
-	map<pair<unsigned int, unsigned int >, double>::const_iterator matrix_iter;
-	map<unsigned int, double>::const_iterator vector_iter;
-	vector<Eigen::Triplet<double>> triplets;
-	Eigen::SparseMatrix < double> A;
-	Eigen::VectorXd b;
-	Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > solver;
-	A.resize(m_number_of_nodes, m_number_of_nodes);
-	b.resize(m_number_of_nodes);
-	m_result.resize(m_number_of_nodes);
-
-	cout << "Solving the system..." << endl << endl;
-
-	for (matrix_iter = m_global_matrix.begin(); matrix_iter != m_global_matrix.end(); ++matrix_iter)
-		triplets.push_back(Eigen::Triplet<double>(matrix_iter->first.first, matrix_iter->first.second, matrix_iter->second));
-
-	m_global_matrix.clear();
-
-	A.setFromTriplets(triplets.begin(), triplets.end());
-
-	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
-		if (m_global_vector.count(i))
-			b(i) = m_global_vector.at(i);
-		else
-			b(i) = 0;
-	}
-
-	m_global_vector.clear();
-
-	solver.compute(A);
-	if (solver.info() != Eigen::Success) {
-		cout << "Error while solving the system!" << endl << endl;
-		return false;
-	}
-
-	m_result = solver.solve(b);
-	if (solver.info() != Eigen::Success) {
-		cout << "Error while solving the system!" << endl << endl;
-		return false;
-	}
-
-	cout << "Task is solved!" << endl << endl;
-
-	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
-		if (m_result(i) > m_max_temperature)
-			m_max_temperature = m_result(i);
-
-		if (m_result(i) < m_min_temperature)
-			m_min_temperature = m_result(i);
-	}
-
-	return true;
-}
-
-double Solver::getTemperatureAtNode(unsigned int  i) const
-{
-	if (i > m_number_of_nodes || i < 0)
-		return DBL_MIN;
-
-	else
-		return m_result(i);
-}
-
-unsigned int  Solver::getNodeCount() const {
-	return m_number_of_nodes;
-}
-
-double Solver::getMaxTemperature() const {
-	return m_max_temperature;
-}
-
-double Solver::getMinTemperature() const {
-	return m_min_temperature;
-}
-
-void Solver::printTemperature() const {
-	for (unsigned int i = 0; i < m_number_of_nodes; ++i)
-		cout << "Temperature at node number " << i << " is " << m_result(i) << endl;
-
-	cout << endl;
-}
-
-void Solver::heatFlowCond(array<double, NODES_PER_ELEMENT>* local_vector, const array<unsigned int, NODES_PER_EDGE>* local_numeration,
-	const FiniteElement* elem, const Edge* edge, const HeatFlowCondition* condition) const {
-
-	const array<double, COORDS_PER_NODE>* edge_center = edge->getCenter();
-	double edge_square = edge->getSquare();
-	double heat_flow = condition->getFlow();
-	unsigned int  current_node_local_id;
-	double coeff;
-	const array<double, NODES_PER_ELEMENT>* coeffs_a = elem->getCoeffsA();
-	const array<double, NODES_PER_ELEMENT>* coeffs_b = elem->getCoeffsB();
-	const array<double, NODES_PER_ELEMENT>* coeffs_c = elem->getCoeffsC();
-	const array<double, NODES_PER_ELEMENT>* coeffs_d = elem->getCoeffsD();
-	array<double, NODES_PER_ELEMENT> center_values;
-	array<unsigned int, NODES_PER_EDGE>::const_iterator local_numeration_iter;
-
-	center_values.fill(0.);
-
-	for (local_numeration_iter = local_numeration->begin(); local_numeration_iter != local_numeration->end(); local_numeration_iter++) {
-		current_node_local_id = *local_numeration_iter;
-		center_values.at(current_node_local_id) = coeffs_a->at(current_node_local_id);
-		center_values.at(current_node_local_id) += edge_center->at(0) * coeffs_b->at(current_node_local_id);
-		center_values.at(current_node_local_id) += edge_center->at(1) * coeffs_c->at(current_node_local_id);
-		center_values.at(current_node_local_id) += edge_center->at(2) * coeffs_d->at(current_node_local_id);
-	}
-
-	coeff = heat_flow * edge_square;
-
-	for (local_numeration_iter = local_numeration->begin(); local_numeration_iter != local_numeration->end(); local_numeration_iter++) {
-		current_node_local_id = *local_numeration_iter;
-		local_vector->at(current_node_local_id) -= center_values.at(current_node_local_id) * coeff;
-	}
-}
-
-void Solver::envirinmentHeatExchangeCond(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
-	array<double, NODES_PER_ELEMENT>* local_vector,
-	const array<unsigned int, NODES_PER_EDGE>* local_numeration,
-	const FiniteElement* elem, const Edge* edge,
-	const EnvironmentHeatExchangeCondition* condition) const {
-
-	double edge_square = edge->getSquare();
-	double exchange_coeff = condition->getEchangeCoeff();
-	double invironment_temp = condition->getEnvironmentTemp();
-	unsigned int  current_node_local_id_1, current_node_local_id_2;
-	double coeff;
-	const array<double, COORDS_PER_NODE>* edge_center = edge->getCenter();
-	const array<double, COORDS_PER_NODE>* point_a = edge->getPointA();
-	const array<double, COORDS_PER_NODE>* point_b = edge->getPointB();
-	const array<double, COORDS_PER_NODE>* point_c = edge->getPointC();
-	const array<double, NODES_PER_ELEMENT>* coeffs_a = elem->getCoeffsA();
-	const array<double, NODES_PER_ELEMENT>* coeffs_b = elem->getCoeffsB();
-	const array<double, NODES_PER_ELEMENT>* coeffs_c = elem->getCoeffsC();
-	const array<double, NODES_PER_ELEMENT>* coeffs_d = elem->getCoeffsD();
-	array<double, NODES_PER_ELEMENT> center_values;
-	array<double, NODES_PER_ELEMENT> point_a_values;
-	array<double, NODES_PER_ELEMENT> point_b_values;
-	array<double, NODES_PER_ELEMENT> point_c_values;
-	array<unsigned int, NODES_PER_EDGE>::const_iterator local_numeration_iter_1, local_numeration_iter_2;
-
-	center_values.fill(0.);
-	point_a_values.fill(0.);
-	point_b_values.fill(0.);
-	point_c_values.fill(0.);
-
-	for (local_numeration_iter_1 = local_numeration->begin(); local_numeration_iter_1 != local_numeration->end(); ++local_numeration_iter_1) {
-		current_node_local_id_1 = *local_numeration_iter_1;
-		center_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
-		center_values.at(current_node_local_id_1) += edge_center->at(0) * coeffs_b->at(current_node_local_id_1);
-		center_values.at(current_node_local_id_1) += edge_center->at(1) * coeffs_c->at(current_node_local_id_1);
-		center_values.at(current_node_local_id_1) += edge_center->at(2) * coeffs_d->at(current_node_local_id_1);
-	}
-
-	coeff = exchange_coeff * invironment_temp * edge_square;
-
-	for (local_numeration_iter_1 = local_numeration->begin(); local_numeration_iter_1 != local_numeration->end(); ++local_numeration_iter_1) {
-		current_node_local_id_1 = *local_numeration_iter_1;
-		local_vector->at(current_node_local_id_1) += center_values.at(current_node_local_id_1) * coeff;
-	}
-
-	for (local_numeration_iter_1 = local_numeration->begin(); local_numeration_iter_1 != local_numeration->end(); ++local_numeration_iter_1) {
-		current_node_local_id_1 = *local_numeration_iter_1;
-
-		point_a_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
-		point_a_values.at(current_node_local_id_1) += coeffs_b->at(current_node_local_id_1) * point_a->at(0);
-		point_a_values.at(current_node_local_id_1) += coeffs_c->at(current_node_local_id_1) * point_a->at(1);
-		point_a_values.at(current_node_local_id_1) += coeffs_d->at(current_node_local_id_1) * point_a->at(2);
-
-		point_b_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
-		point_b_values.at(current_node_local_id_1) += coeffs_b->at(current_node_local_id_1) * point_b->at(0);
-		point_b_values.at(current_node_local_id_1) += coeffs_c->at(current_node_local_id_1) * point_b->at(1);
-		point_b_values.at(current_node_local_id_1) += coeffs_d->at(current_node_local_id_1) * point_b->at(2);
-
-		point_c_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
-		point_c_values.at(current_node_local_id_1) += coeffs_b->at(current_node_local_id_1) * point_c->at(0);
-		point_c_values.at(current_node_local_id_1) += coeffs_c->at(current_node_local_id_1) * point_c->at(1);
-		point_c_values.at(current_node_local_id_1) += coeffs_d->at(current_node_local_id_1) * point_c->at(2);
-
-		center_values.at(current_node_local_id_1) = point_a_values.at(current_node_local_id_1);
-		center_values.at(current_node_local_id_1) += point_b_values.at(current_node_local_id_1);
-		center_values.at(current_node_local_id_1) += point_c_values.at(current_node_local_id_1);
-		center_values.at(current_node_local_id_1) /= NODES_PER_EDGE;
-	}
-
-	coeff = edge_square * exchange_coeff;
-
-	for (local_numeration_iter_1 = local_numeration->begin(); local_numeration_iter_1 != local_numeration->end(); ++local_numeration_iter_1) {
-		current_node_local_id_1 = *local_numeration_iter_1;
-
-		for (local_numeration_iter_2 = local_numeration->begin(); local_numeration_iter_2 != local_numeration->end(); ++local_numeration_iter_2) {
-			current_node_local_id_2 = *local_numeration_iter_2;
-
-			local_matrix->at(current_node_local_id_1).at(current_node_local_id_2) +=
-				center_values.at(current_node_local_id_1) * center_values.at(current_node_local_id_2) * coeff;
-		}
-	}
-}
-
-void Solver::setupLocalNumeration(array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration) const {
-	local_numeration->at(0) = { 0,1,2 };
-	local_numeration->at(1) = { 1,2,3 };
-	local_numeration->at(2) = { 0,1,3 };
-	local_numeration->at(3) = { 0,2,3 };
-}
-
-void Solver::setToGlobalMatrix(unsigned int  i, unsigned int  j, double value) {
-	if (value == 0)
-		m_global_matrix.erase(pair<unsigned int, unsigned int >(i, j));
-
-	else
-		m_global_matrix[pair<unsigned int, unsigned int >(i, j)] = value;
-}
-
-void Solver::addToGlobalMatrix(unsigned int  i, unsigned int  j, double value) {
-	if (value != 0)
-		m_global_matrix[pair<unsigned int, unsigned int >(i, j)] += value;
-}
-
-double Solver::getFromGlobalMatrix(unsigned int  i, unsigned int  j) const {
-	pair<unsigned int, unsigned int > pair(i, j);
-
-	if (m_global_matrix.count(pair))
-		return m_global_matrix.at(pair);
-
-	return 0.;
-}
-
-void Solver::setToGlobalVector(unsigned int  i, double value) {
-	if (value == 0)
-		m_global_vector.erase(i);
-
-	else
-		m_global_vector[i] = value;
-}
-
-void Solver::addToGlobalVector(unsigned int  i, double value) {
-	if (value != 0)
-		m_global_vector[i] += value;
-}
-
-double Solver::getFromGlobalVector(unsigned int  i) const {
-	if (m_global_vector.count(i))
-		return m_global_vector.at(i);
-
-	return 0.;
-}
-
-void Solver::setupBoundaryEdges(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
-	const array<unsigned int, NODES_PER_ELEMENT>* nodes_id,
-	array<const Edge*, NODES_PER_ELEMENT>* boundary_edges) const {
-	array < array< unsigned int, NODES_PER_EDGE >, EDGES_PER_ELEMENT > ids_of_edge_nodes;
-	const Edge* edge;
-
-	boundary_edges->fill(0);
-
-	for (unsigned int i = 0; i < EDGES_PER_ELEMENT; ++i)
-		for (unsigned int j = 0; j < NODES_PER_EDGE; ++j)
-			ids_of_edge_nodes.at(i).at(j) = nodes_id->at((*local_numeration)[i][j]);
-
-	for (unsigned int i = 0; i < ids_of_edge_nodes.size(); ++i) {
-		edge = m_data_loader->getIfBoundary(&ids_of_edge_nodes.at(i));
-		boundary_edges->at(i) = edge;
-	}
-}
-
-void Solver::initLocalMatrix(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* matrix,
-	const FiniteElement* elem, double heat_conduction_coeff) const {
-	const array<double, NODES_PER_ELEMENT>* b_coeffs = elem->getCoeffsB();
-	const array<double, NODES_PER_ELEMENT>* c_coeffs = elem->getCoeffsC();
-	const array<double, NODES_PER_ELEMENT>* d_coeffs = elem->getCoeffsD();
-	double volume = elem->getVolume();
-	double coeff = heat_conduction_coeff * volume;
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
-		matrix->at(i).fill(0.);
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
-		for (unsigned int j = i; j < NODES_PER_ELEMENT; ++j) {
-			matrix->at(i).at(j) = b_coeffs->at(i) * b_coeffs->at(j);
-			matrix->at(i).at(j) += c_coeffs->at(i) * c_coeffs->at(j);
-			matrix->at(i).at(j) += d_coeffs->at(i) * d_coeffs->at(j);
-			matrix->at(i).at(j) *= coeff;
-		}
-
-	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
-		for (unsigned int j = 0; j < i; ++j)
-			matrix->at(i).at(j) = matrix->at(j).at(i);
-}
\ No newline at end of file
+#include "Solver.h"
+
+Solver::Solver(const DataLoader* data_loader) :
+	m_number_of_nodes(data_loader->getNodeCount()), m_number_of_threads(getDefaultThreadCount()),
+	m_solver_type(CHOLESKY_SOLVER), m_analysis_type(STEADY_ANALYSIS), m_assembly_type(COLORED_ASSEMBLY), m_storage_type(FULL_STORAGE), m_dirichlet_mode(ELIMINATION_DIRICHLET), m_preconditioner_type(INCOMPLETE_CHOLESKY_PRECONDITIONER),
+	m_smoother_type(CHEBYSHEV_SMOOTHER), m_tolerance(DEFAULT_PCG_TOLERANCE),
+	m_max_iterations(DEFAULT_PCG_MAX_ITERATIONS), m_iteration_count(0), m_residual(0),
+	m_heat_capacity(0), m_time_step(0), m_theta(DEFAULT_THETA), m_penalty_factor(DEFAULT_PENALTY_FACTOR), m_initial_temperature(0), m_number_of_steps(0),
+	m_output_interval(DEFAULT_OUTPUT_INTERVAL), m_max_temperature(DBL_MIN), m_min_temperature(DBL_MAX),
+	m_data_loader(data_loader), m_profiler(nullptr), m_analysis_count(0), m_factorization_count(0) {
+}
+
+void Solver::setThreadCount(unsigned int number_of_threads) {
+	if (number_of_threads == 0)
+		m_number_of_threads = getDefaultThreadCount();
+
+	else
+		m_number_of_threads = number_of_threads;
+}
+
+void Solver::setProfiler(Profiler* profiler) {
+	m_profiler = profiler;
+}
+
+void Solver::setSolverType(SolverType solver_type) {
+	m_solver_type = solver_type;
+}
+
+void Solver::setPreconditionerType(PreconditionerType preconditioner_type) {
+	m_preconditioner_type = preconditioner_type;
+}
+
+void Solver::setSmootherType(SmootherType smoother_type) {
+	m_smoother_type = smoother_type;
+}
+
+void Solver::setTolerance(double tolerance) {
+	m_tolerance = tolerance;
+}
+
+void Solver::setMaxIterations(unsigned int max_iterations) {
+	m_max_iterations = max_iterations;
+}
+
+void Solver::setAnalysisType(AnalysisType analysis_type) {
+	m_analysis_type = analysis_type;
+}
+
+void Solver::setAssemblyType(AssemblyType assembly_type) {
+	m_assembly_type = assembly_type;
+}
+
+void Solver::setStorageType(StorageType storage_type) {
+	m_storage_type = storage_type;
+}
+
+void Solver::setDirichletMode(DirichletMode dirichlet_mode) {
+	m_dirichlet_mode = dirichlet_mode;
+}
+
+void Solver::setPenaltyFactor(double penalty_factor) {
+	m_penalty_factor = penalty_factor;
+}
+
+void Solver::setHeatCapacity(double heat_capacity) {
+	m_heat_capacity = heat_capacity;
+}
+
+void Solver::setTimeStepping(double time_step, unsigned int number_of_steps, double theta) {
+	m_time_step = time_step;
+	m_number_of_steps = number_of_steps;
+	m_theta = theta;
+}
+
+void Solver::setInitialTemperature(double temperature) {
+	m_initial_temperature = temperature;
+}
+
+void Solver::setOutputInterval(unsigned int output_interval) {
+	m_output_interval = output_interval == 0 ? 1 : output_interval;
+}
+
+void Solver::initLocalVector(array<double, NODES_PER_ELEMENT>* local_vector) const {
+	local_vector->fill(0.);
+}
+
+// Consistent mass matrix of a linear tetrahedron: heat_capacity * volume / 20 * (1 + delta_ij)
+void Solver::initLocalMassMatrix(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
+	const FiniteElement* elem, double heat_capacity) const {
+	double coeff = heat_capacity * elem->getVolume() / 20.;
+
+	for (unsigned int i = 0; i < NODES_PER_ELEMENT; ++i)
+		for (unsigned int j = 0; j < NODES_PER_ELEMENT; ++j)
+			local_matrix->at(i).at(j) = i == j ? 2. * coeff : coeff;
+}
+
+// Turns the assembled conductivity matrix K into (M / dt + theta * K) and keeps
+// (M / dt - (1 - theta) * K) for the right-hand side of every step. Rows of the
+// constant temperature nodes are zeroed there, their value comes from the lifted vector
+void Solver::prepareTransient(const map<unsigned int, double>* nodes_with_const_temp) {
+	map<unsigned int, double>::const_iterator find_iter;
+	vector<bool> is_constrained(m_number_of_nodes, false);
+
+	m_initial_state = Eigen::VectorXd::Constant(m_number_of_nodes, m_initial_temperature);
+
+	for (find_iter = nodes_with_const_temp->begin(); find_iter != nodes_with_const_temp->end(); ++find_iter) {
+		is_constrained.at(find_iter->first) = true;
+		m_initial_state(find_iter->first) = find_iter->second;
+	}
+
+	m_explicit_matrix = m_global_matrix;
+	m_explicit_matrix.setLinearCombination(1. / m_time_step, &m_mass_matrix, m_theta - 1., &m_global_matrix);
+	m_explicit_matrix.setRowsZero(&is_constrained);
+
+	m_global_matrix.setLinearCombination(1. / m_time_step, &m_mass_matrix, m_theta, &m_global_matrix);
+	m_mass_matrix.clear();
+}
+
+void Solver::applyConstantTempCond(const map<unsigned int, double>* nodes_with_const_temp) {
+	ProfilerScope scope(m_profiler, "constant temperature conditions");
+	double temperature, tmp_value;
+	unsigned int  current_j;
+	const vector<int>* row_ptr = m_global_matrix.getRowPtr();
+	const vector<int>* col_ids = m_global_matrix.getColIds();
+	const vector<double>* values = m_global_matrix.getValues();
+	map<unsigned int, double>::const_iterator find_iter;
+	vector<bool> is_constrained(m_number_of_nodes, false);
+
+	for (find_iter = nodes_with_const_temp->begin(); find_iter != nodes_with_const_temp->end(); ++find_iter)
+		is_constrained.at(find_iter->first) = true;
+
+	// an upper matrix holds the coupling of a constrained node with the free nodes after it in its own row
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+		if (is_constrained.at(i)) {
+			temperature = nodes_with_const_temp->at(i);
+			setToGlobalVector(i, m_global_matrix.getValue(i, i) * temperature);
+
+			if (m_global_matrix.getStorageType() == UPPER_STORAGE)
+				for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k)
+					if (!is_constrained.at(col_ids->at(k)))
+						addToGlobalVector(col_ids->at(k), -values->at(k) * temperature);
+			continue;
+		}
+
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+			current_j = col_ids->at(k);
+
+			if (!is_constrained.at(current_j))
+				continue;
+
+			temperature = nodes_with_const_temp->at(current_j);
+			tmp_value = values->at(k);
+			addToGlobalVector(i, -tmp_value * temperature);
+		}
+	}
+
+	if (m_dirichlet_mode == LIFTING_DIRICHLET)
+		m_global_matrix.zeroOffDiagonalEntries(&is_constrained);
+	else
+		m_global_matrix.removeOffDiagonalEntries(&is_constrained);
+}
+
+// The diagonal of a constrained node is scaled by the penalty factor and its value is taken from the
+// global vector. The matrix keeps its pattern and symmetry, the other equations are not changed
+void Solver::applyConstantTempPenalty(const map<unsigned int, double>* nodes_with_const_temp,
+	const vector<map<unsigned int, double>>* load_case_temps) {
+	ProfilerScope scope(m_profiler, "constant temperature conditions");
+	double diagonal;
+	unsigned int current_i;
+	map<unsigned int, double>::const_iterator find_iter;
+
+	for (find_iter = nodes_with_const_temp->begin(); find_iter != nodes_with_const_temp->end(); ++find_iter) {
+		current_i = find_iter->first;
+		diagonal = m_global_matrix.getValue(current_i, current_i) * m_penalty_factor;
+
+		setToGlobalMatrix(current_i, current_i, diagonal);
+		setToGlobalVector(current_i, diagonal * find_iter->second);
+
+		for (unsigned int c = 0; c < load_case_temps->size(); ++c)
+			m_load_case_vectors(current_i, c) = diagonal * load_case_temps->at(c).at(current_i);
+	}
+}
+
+// Static condensation: the constrained nodes leave the system, the free ones keep their order.
+// m_condensed_ids holds the new id of a free node and -(k + 1) for the k-th constrained node,
+// whose temperatures in the base conditions and in every load case are kept in m_constrained_values
+void Solver::condenseConstantTempCond(const map<unsigned int, double>* nodes_with_const_temp,
+	const vector<map<unsigned int, double>>* load_case_temps) {
+	ProfilerScope scope(m_profiler, "constant temperature conditions");
+	unsigned int number_of_free_nodes = 0;
+	unsigned int number_of_cases = load_case_temps->size();
+	unsigned int constrained_id;
+	int current_id;
+	const vector<int>* row_ptr = m_global_matrix.getRowPtr();
+	const vector<int>* col_ids = m_global_matrix.getColIds();
+	const vector<double>* values = m_global_matrix.getValues();
+	map<unsigned int, double>::const_iterator find_iter;
+	LoadCaseBlock load_case_vectors;
+
+	m_condensed_ids.resize(m_number_of_nodes);
+	m_constrained_values.resize(nodes_with_const_temp->size(), number_of_cases + 1);
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+		find_iter = nodes_with_const_temp->find(i);
+
+		if (find_iter == nodes_with_const_temp->end()) {
+			m_condensed_ids.at(i) = number_of_free_nodes++;
+			continue;
+		}
+
+		constrained_id = i - number_of_free_nodes;
+		m_condensed_ids.at(i) = -(int)constrained_id - 1;
+		m_constrained_values(constrained_id, 0) = find_iter->second;
+		for (unsigned int c = 0; c < number_of_cases; ++c)
+			m_constrained_values(constrained_id, c + 1) = load_case_temps->at(c).at(i);
+	}
+
+	// the constrained columns of the free rows form the K_fc block, it is only needed for lifting.
+	// In an upper matrix its entries after the diagonal are stored in the constrained rows
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+		if (m_condensed_ids.at(i) < 0) {
+			if (m_global_matrix.getStorageType() == UPPER_STORAGE)
+				for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k)
+					if (m_condensed_ids.at(col_ids->at(k)) >= 0)
+						addToGlobalVector(col_ids->at(k), -values->at(k) * m_constrained_values(-m_condensed_ids.at(i) - 1, 0));
+			continue;
+		}
+
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+			current_id = m_condensed_ids.at(col_ids->at(k));
+
+			if (current_id < 0)
+				addToGlobalVector(i, -values->at(k) * m_constrained_values(-current_id - 1, 0));
+		}
+	}
+
+	if (number_of_cases != 0) {
+		load_case_vectors.resize(number_of_free_nodes, number_of_cases);
+		for (unsigned int i = 0; i < m_number_of_nodes; ++i)
+			if (m_condensed_ids.at(i) >= 0)
+				load_case_vectors.row(m_condensed_ids.at(i)) = m_load_case_vectors.row(i);
+		m_load_case_vectors.swap(load_case_vectors);
+	}
+
+	m_global_matrix.condense(&m_condensed_ids, number_of_free_nodes);
+}
+
+void Solver::condenseVector(Eigen::VectorXd* vector) const {
+	Eigen::VectorXd condensed_vector(m_global_matrix.getRowCount());
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i)
+		if (m_condensed_ids.at(i) >= 0)
+			condensed_vector(m_condensed_ids.at(i)) = (*vector)(i);
+
+	vector->swap(condensed_vector);
+}
+
+void Solver::expandCondensedResult() {
+	Eigen::VectorXd condensed_result;
+	LoadCaseBlock condensed_load_case_results;
+	int current_id;
+
+	condensed_result.swap(m_result);
+	condensed_load_case_results.swap(m_load_case_results);
+
+	m_result.resize(m_number_of_nodes);
+	m_load_case_results.resize(condensed_load_case_results.rows() == 0 ? 0 : m_number_of_nodes, condensed_load_case_results.cols());
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+		current_id = m_condensed_ids.at(i);
+
+		if (current_id >= 0) {
+			m_result(i) = condensed_result(current_id);
+			if (m_load_case_results.rows() != 0)
+				m_load_case_results.row(i) = condensed_load_case_results.row(current_id);
+			continue;
+		}
+
+		m_result(i) = m_constrained_values(-current_id - 1, 0);
+		if (m_load_case_results.rows() != 0)
+			m_load_case_results.row(i) = m_constrained_values.row(-current_id - 1);
+	}
+}
+
+// Same lifting as applyConstantTempCond for every load case. The constrained nodes are the same in all
+// cases, only their temperatures differ, so it has to run before the matrix entries are removed
+void Solver::applyConstantTempCondToLoadCases(const map<unsigned int, double>* nodes_with_const_temp,
+	const vector<map<unsigned int, double>>* load_case_temps) {
+	unsigned int number_of_cases = m_load_case_vectors.cols();
+	unsigned int  current_j;
+	const vector<int>* row_ptr = m_global_matrix.getRowPtr();
+	const vector<int>* col_ids = m_global_matrix.getColIds();
+	const vector<double>* values = m_global_matrix.getValues();
+	map<unsigned int, double>::const_iterator find_iter;
+	vector<bool> is_constrained(m_number_of_nodes, false);
+
+	for (find_iter = nodes_with_const_temp->begin(); find_iter != nodes_with_const_temp->end(); ++find_iter)
+		is_constrained.at(find_iter->first) = true;
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+		if (is_constrained.at(i)) {
+			for (unsigned int c = 0; c < number_of_cases; ++c)
+				m_load_case_vectors(i, c) = m_global_matrix.getValue(i, i) * load_case_temps->at(c).at(i);
+
+			if (m_global_matrix.getStorageType() == UPPER_STORAGE)
+				for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+					current_j = col_ids->at(k);
+					if (is_constrained.at(current_j))
+						continue;
+
+					for (unsigned int c = 0; c < number_of_cases; ++c)
+						m_load_case_vectors(current_j, c) -= values->at(k) * load_case_temps->at(c).at(i);
+				}
+			continue;
+		}
+
+		for (int k = row_ptr->at(i); k < row_ptr->at(i + 1); ++k) {
+			current_j = col_ids->at(k);
+
+			if (!is_constrained.at(current_j))
+				continue;
+
+			for (unsigned int c = 0; c < number_of_cases; ++c)
+				m_load_case_vectors(i, c) -= values->at(k) * load_case_temps->at(c).at(current_j);
+		}
+	}
+}
+
+// Boundary faces are summed in the same order as for the base conditions, so a load case equal
+// to them gets exactly the same vector
+void Solver::assembleLoadCaseVector(unsigned int case_id, const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
+	map<unsigned int, double>* nodes_with_const_temp) {
+	const Edge* current_edge;
+	const FiniteElement* current_elem;
+	const BoundaryFace* current_face;
+	const Condition* current_condition;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	array<double, NODES_PER_ELEMENT> local_vector;
+
+	for (unsigned int i = 0; i < m_data_loader->getBoundaryFaceCount(); ++i) {
+		current_face = m_data_loader->getBoundaryFace(i);
+		current_edge = m_data_loader->getBoundaryEdge(current_face->edge_id);
+		current_elem = m_data_loader->getElement(current_face->element_id);
+		current_condition = m_data_loader->getLoadCaseCondition(case_id, current_edge->getSurfaceId());
+		initLocalVector(&local_vector);
+
+		switch (current_condition->getType()) {
+		case HEAT_FLOW:
+			heatFlowCond(&local_vector, &local_numeration->at(current_face->local_face_id), current_elem, current_edge,
+				static_cast<const HeatFlowCondition*>(current_condition));
+			break;
+		case ENVIRONMENT_HEAT_EXCHANGE:
+			envirinmentHeatExchangeVector(&local_vector, &local_numeration->at(current_face->local_face_id), current_elem, current_edge,
+				static_cast<const EnvironmentHeatExchangeCondition*>(current_condition));
+			break;
+		default:
+			break;
+		}
+
+		current_elem_nodes_id = current_elem->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			m_load_case_vectors(current_elem_nodes_id->at(k), case_id) += local_vector[k];
+	}
+
+	collectConstantTemps(case_id, nodes_with_const_temp);
+}
+
+// Where two surfaces with constant temperature meet, the face that comes later in the mesh file sets the
+// temperature of the shared nodes, also after the elements were reordered by renumberNodes.
+// The base conditions are taken for a case id of -1
+void Solver::collectConstantTemps(int case_id, map<unsigned int, double>* nodes_with_const_temp) const {
+	double temperature;
+	const Edge* current_edge;
+	const Condition* current_condition;
+	const array<unsigned int, 3>* current_edge_nodes_ids;
+
+	for (unsigned int i = 0; i < m_data_loader->getBoundaryFaceCount(); ++i) {
+		current_edge = m_data_loader->getBoundaryEdge(m_data_loader->getBoundaryFace(m_data_loader->getMeshOrderBoundaryFaceId(i))->edge_id);
+		if (case_id < 0)
+			current_condition = m_data_loader->getSurface(current_edge->getSurfaceId())->getCondition();
+		else
+			current_condition = m_data_loader->getLoadCaseCondition(case_id, current_edge->getSurfaceId());
+
+		if (current_condition->getType() != CONSTANT_TEMPERATURE)
+			continue;
+
+		temperature = static_cast<const ConstantTempCondition*>(current_condition)->getTemperature();
+		current_edge_nodes_ids = current_edge->getRightIdsOrder();
+		(*nodes_with_const_temp)[current_edge_nodes_ids->at(0)] = temperature;
+		(*nodes_with_const_temp)[current_edge_nodes_ids->at(1)] = temperature;
+		(*nodes_with_const_temp)[current_edge_nodes_ids->at(2)] = temperature;
+	}
+}
+
+// The vector and the environment heat exchange matrix of one boundary face for the current surface conditions
+bool Solver::setBoundaryFaceArrays(unsigned int face_id, const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration) {
+	const BoundaryFace* current_face = m_data_loader->getBoundaryFace(face_id);
+	const Edge* current_edge = m_data_loader->getBoundaryEdge(current_face->edge_id);
+	const FiniteElement* current_elem = m_data_loader->getElement(current_face->element_id);
+	Condition* current_condition = m_data_loader->getSurface(current_edge->getSurfaceId())->getCondition();
+	array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* current_face_matrix = &m_face_matrices.at(face_id);
+	array<double, NODES_PER_ELEMENT>* current_vector = &m_boundary_vectors.at(face_id);
+
+	initLocalVector(current_vector);
+	for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+		current_face_matrix->at(k).fill(0.);
+
+	switch (current_condition->getType()) {
+	case CONSTANT_TEMPERATURE:
+		break;
+	case NO_HEAT_EXCHANGE:
+		break;
+	case HEAT_FLOW:
+		heatFlowCond(current_vector, &local_numeration->at(current_face->local_face_id), current_elem, current_edge,
+			static_cast<HeatFlowCondition*>(current_condition));
+		break;
+	case ENVIRONMENT_HEAT_EXCHANGE:
+		envirinmentHeatExchangeCond(current_face_matrix, current_vector, &local_numeration->at(current_face->local_face_id), current_elem, current_edge,
+			static_cast<EnvironmentHeatExchangeCondition*>(current_condition));
+		break;
+	default:
+		return false;
+		break;
+	}
+
+	return true;
+}
+
+// Without a coloring the positions are element ids. The local matrices go to the triplet buffers when
+// they are given and through the scatter map to the preallocated matrices otherwise. The environment heat
+// exchange is kept in the face matrices, it is added to the triplets here and to the preallocated global
+// matrix only when it is scaled
+bool Solver::assembleElements(const ElementColoring* coloring, const ElementStore* element_store, unsigned int begin, unsigned int end,
+	const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
+	double heat_conduction_coeff, vector<CooEntry>* matrix_entries, vector<CooEntry>* mass_entries) {
+	unsigned int  current_elem_id;
+	const Edge* current_edge;
+	const FiniteElement* current_elem;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	const ElementOffsets* current_offsets;
+	array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT> local_matrix;
+	array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT> local_mass_matrix;
+	ElementBatchMatrices batch_matrices;
+
+	for (unsigned int i = begin; i < end; ++i) {
+		current_elem_id = coloring != nullptr ? coloring->getElement(i) : i;
+		current_elem = m_data_loader->getElement(current_elem_id);
+		current_elem_nodes_id = current_elem->getNodesId();
+
+		if ((i - begin) % ELEMENT_BATCH_SIZE == 0)
+			element_store->computeLocalMatrices(i, heat_conduction_coeff, &batch_matrices);
+		ElementKernels::getLocalMatrix(&batch_matrices, (i - begin) % ELEMENT_BATCH_SIZE, &local_matrix);
+
+		// every boundary face belongs to a single element, so its arrays are written by one thread only
+		for (unsigned int j = m_data_loader->getElementBoundaryFacesBegin(current_elem_id);
+			j < m_data_loader->getElementBoundaryFacesEnd(current_elem_id); ++j) {
+			if (!setBoundaryFaceArrays(j, local_numeration))
+				return false;
+
+			current_edge = m_data_loader->getBoundaryEdge(m_data_loader->getBoundaryFace(j)->edge_id);
+			if (matrix_entries != nullptr &&
+				m_data_loader->getSurface(current_edge->getSurfaceId())->getCondition()->getType() == ENVIRONMENT_HEAT_EXCHANGE)
+				for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+					for (unsigned int l = 0; l < NODES_PER_ELEMENT; ++l)
+						local_matrix.at(k).at(l) += m_face_matrices.at(j).at(k).at(l);
+		}
+
+		// the local matrices are symmetric, an upper matrix gets every pair of nodes once at its stored entry
+		current_offsets = matrix_entries == nullptr ? &m_scatter_map.at(current_elem_id) : nullptr;
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			for (unsigned int l = m_storage_type == UPPER_STORAGE ? k : 0; l < NODES_PER_ELEMENT; ++l) {
+				if (matrix_entries != nullptr)
+					matrix_entries->push_back(getTriplet(current_elem_nodes_id->at(k), current_elem_nodes_id->at(l), local_matrix.at(k).at(l)));
+				else
+					m_stiffness_matrix.addToOffset(current_offsets->at(k * NODES_PER_ELEMENT + l), local_matrix.at(k).at(l));
+			}
+
+		if (m_analysis_type != TRANSIENT_ANALYSIS)
+			continue;
+
+		initLocalMassMatrix(&local_mass_matrix, current_elem, m_heat_capacity);
+
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			for (unsigned int l = m_storage_type == UPPER_STORAGE ? k : 0; l < NODES_PER_ELEMENT; ++l) {
+				if (mass_entries != nullptr)
+					mass_entries->push_back(getTriplet(current_elem_nodes_id->at(k), current_elem_nodes_id->at(l), local_mass_matrix.at(k).at(l)));
+				else
+					m_mass_matrix.addToOffset(current_offsets->at(k * NODES_PER_ELEMENT + l), local_mass_matrix.at(k).at(l));
+			}
+	}
+
+	return true;
+}
+
+// The global matrix is never built. Only the boundary faces are processed here, the elements are
+// applied by the operator in every iteration of the conjugate gradient method
+bool Solver::setMatrixFreeArrays() {
+	const FiniteElement* current_elem;
+	const Edge* current_edge;
+	const BoundaryFace* current_face;
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	Condition* current_condition;
+	array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT> local_numeration;
+	array<double, NODES_PER_ELEMENT> local_vector;
+	vector<array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>> face_matrices(m_data_loader->getBoundaryFaceCount());
+	map<unsigned int, double> nodes_with_const_temp;
+	map<unsigned int, double>::const_iterator find_iter;
+	vector<bool> is_constrained(m_number_of_nodes, false);
+	Eigen::VectorXd constrained_values, lifted_values;
+
+	FiniteElement::setupLocalNumeration(&local_numeration);
+	m_condensed_ids.clear();
+
+	cout << "Preparing matrix-free operator using " << m_number_of_threads << " threads and "
+		<< ElementKernels::getInstructionSet() << " element kernels..." << endl << endl;
+
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("boundary faces");
+
+	for (unsigned int i = 0; i < m_data_loader->getBoundaryFaceCount(); ++i) {
+		current_face = m_data_loader->getBoundaryFace(i);
+		current_elem = m_data_loader->getElement(current_face->element_id);
+		current_edge = m_data_loader->getBoundaryEdge(current_face->edge_id);
+		current_condition = m_data_loader->getSurface(current_edge->getSurfaceId())->getCondition();
+		initLocalVector(&local_vector);
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			face_matrices.at(i).at(k).fill(0.);
+
+		switch (current_condition->getType()) {
+		case CONSTANT_TEMPERATURE:
+			break;
+		case NO_HEAT_EXCHANGE:
+			break;
+		case HEAT_FLOW:
+			heatFlowCond(&local_vector, &local_numeration.at(current_face->local_face_id), current_elem, current_edge,
+				static_cast<HeatFlowCondition*>(current_condition));
+			break;
+		case ENVIRONMENT_HEAT_EXCHANGE:
+			envirinmentHeatExchangeCond(&face_matrices.at(i), &local_vector, &local_numeration.at(current_face->local_face_id),
+				current_elem, current_edge, static_cast<EnvironmentHeatExchangeCondition*>(current_condition));
+			break;
+		default:
+			cout << "Error while constructing global arrays. Unknown boundary condition type!" << endl;
+			return false;
+		}
+
+		current_elem_nodes_id = current_elem->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			addToGlobalVector(current_elem_nodes_id->at(k), local_vector[k]);
+	}
+
+	collectConstantTemps(-1, &nodes_with_const_temp);
+
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("matrix-free operator");
+	}
+
+	for (find_iter = nodes_with_const_temp.begin(); find_iter != nodes_with_const_temp.end(); ++find_iter)
+		is_constrained.at(find_iter->first) = true;
+
+	m_matrix_free.init(m_data_loader, m_data_loader->getHeatConductionCoeff(), &face_matrices, &is_constrained);
+
+	if (m_profiler != nullptr)
+		m_profiler->endPhase();
+
+	if (nodes_with_const_temp.size() != 0) {
+		ProfilerScope scope(m_profiler, "constant temperature conditions");
+
+		constrained_values.setZero(m_number_of_nodes);
+		for (find_iter = nodes_with_const_temp.begin(); find_iter != nodes_with_const_temp.end(); ++find_iter)
+			constrained_values(find_iter->first) = find_iter->second;
+
+		m_matrix_free.multiplyUnconstrained(&constrained_values, &lifted_values, m_number_of_threads);
+
+		for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+			if (is_constrained.at(i))
+				setToGlobalVector(i, (*m_matrix_free.getDiagonal())(i) * constrained_values(i));
+			else
+				addToGlobalVector(i, -lifted_values(i));
+		}
+	}
+
+	if (m_profiler != nullptr) {
+		m_profiler->setCounter("nodes", m_number_of_nodes);
+		m_profiler->setCounter("unknowns", m_number_of_nodes);
+		m_profiler->setCounter("elements", m_data_loader->getElementCount());
+		m_profiler->setCounter("boundary_faces", m_data_loader->getBoundaryFaceCount());
+		m_profiler->setCounter("threads", m_number_of_threads);
+		m_profiler->setCounter("operator_bytes", m_matrix_free.getMemorySize());
+	}
+
+	return true;
+}
+
+// The conduction part is assembled for a unit heat conduction coefficient into the stiffness matrix, the
+// global matrix is made from it by scaleStiffnessMatrix
+bool Solver::assembleColored(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration) {
+	ElementColoring coloring;
+	ElementStore element_store;
+	atomic<bool> unknown_condition(false);
+
+	cout << "Building sparsity pattern of global matrix..." << endl << endl;
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("sparsity pattern");
+	m_stiffness_matrix.setStorageType(m_storage_type);
+	m_stiffness_matrix.initPattern(m_data_loader);
+	if (m_analysis_type == TRANSIENT_ANALYSIS)
+		m_mass_matrix = m_stiffness_matrix;
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("scatter map");
+	}
+	m_scatter_map.resize(m_data_loader->getElementCount());
+	parallelFor(0, m_data_loader->getElementCount(), m_number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i)
+			m_stiffness_matrix.getElementOffsets(m_data_loader->getElement(i)->getNodesId(), &m_scatter_map[i]);
+	});
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("element coloring");
+	}
+	coloring.init(m_data_loader);
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("element store");
+	}
+	element_store.init(m_data_loader, &coloring);
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("element assembly");
+	}
+
+	cout << "Calculating global marix and global vector using " << m_number_of_threads << " threads, "
+		<< coloring.getColorCount() << " element colors and " << ElementKernels::getInstructionSet() << " element kernels..." << endl << endl;
+
+	// elements of one color share no nodes, so they never write the same matrix entry. The colors are
+	// processed in a fixed order, which keeps the result independent of the number of threads
+	for (unsigned int color = 0; color < coloring.getColorCount(); ++color)
+		parallelFor(coloring.getColorBegin(color), coloring.getColorEnd(color), m_number_of_threads,
+			[&](unsigned int, unsigned int begin, unsigned int end) {
+				if (!assembleElements(&coloring, &element_store, begin, end, local_numeration, 1., nullptr, nullptr))
+					unknown_condition = true;
+			});
+
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->setCounter("colors", coloring.getColorCount());
+	}
+
+	return !unknown_condition;
+}
+
+// Every boundary face belongs to a single element and writes only its own arrays
+bool Solver::assembleBoundaryFaces(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration) {
+	ProfilerScope scope(m_profiler, "boundary faces");
+	atomic<bool> unknown_condition(false);
+
+	parallelFor(0, m_data_loader->getBoundaryFaceCount(), m_number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i)
+			if (!setBoundaryFaceArrays(i, local_numeration))
+				unknown_condition = true;
+	});
+
+	return !unknown_condition;
+}
+
+// One pass over the values and an indexed add of the environment heat exchange faces, no entry is searched
+void Solver::scaleStiffnessMatrix(double heat_conduction_coeff) {
+	ProfilerScope scope(m_profiler, "conduction scaling");
+	const Edge* current_edge;
+	const BoundaryFace* current_face;
+	const ElementOffsets* current_offsets;
+
+	m_global_matrix.setScaled(heat_conduction_coeff, &m_stiffness_matrix);
+
+	for (unsigned int i = 0; i < m_data_loader->getBoundaryFaceCount(); ++i) {
+		current_face = m_data_loader->getBoundaryFace(i);
+		current_edge = m_data_loader->getBoundaryEdge(current_face->edge_id);
+		if (m_data_loader->getSurface(current_edge->getSurfaceId())->getCondition()->getType() != ENVIRONMENT_HEAT_EXCHANGE)
+			continue;
+
+		current_offsets = &m_scatter_map.at(current_face->element_id);
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			for (unsigned int l = m_storage_type == UPPER_STORAGE ? k : 0; l < NODES_PER_ELEMENT; ++l)
+				m_global_matrix.addToOffset(current_offsets->at(k * NODES_PER_ELEMENT + l), m_face_matrices.at(i).at(k).at(l));
+	}
+}
+
+// Every thread writes the contributions of its contiguous chunk of elements to private buffers, no
+// pattern or coloring is needed. The buffers are merged by CsrMatrix::setFromTriplets
+bool Solver::assembleTriplets(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
+	double heat_conduction_coeff) {
+	ElementStore element_store;
+	vector<vector<CooEntry>> matrix_entries(m_number_of_threads);
+	vector<vector<CooEntry>> mass_entries(m_analysis_type == TRANSIENT_ANALYSIS ? m_number_of_threads : 0);
+	atomic<bool> unknown_condition(false);
+
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("element store");
+	element_store.init(m_data_loader, nullptr);
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("element triplets");
+	}
+
+	cout << "Calculating global marix triplets and global vector using " << m_number_of_threads << " threads and "
+		<< ElementKernels::getInstructionSet() << " element kernels..." << endl << endl;
+
+	parallelFor(0, m_data_loader->getElementCount(), m_number_of_threads, [&](unsigned int thread_id, unsigned int begin, unsigned int end) {
+		matrix_entries[thread_id].reserve((end - begin) * NODES_PER_ELEMENT * NODES_PER_ELEMENT);
+		if (mass_entries.size() != 0)
+			mass_entries[thread_id].reserve((end - begin) * NODES_PER_ELEMENT * NODES_PER_ELEMENT);
+
+		if (!assembleElements(nullptr, &element_store, begin, end, local_numeration, heat_conduction_coeff, &matrix_entries[thread_id], mass_entries.size() != 0 ? &mass_entries[thread_id] : nullptr))
+			unknown_condition = true;
+	});
+
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->beginPhase("triplet sort");
+	}
+
+	m_global_matrix.setStorageType(m_storage_type);
+	m_mass_matrix.setStorageType(m_storage_type);
+	m_global_matrix.setFromTriplets(m_number_of_nodes, m_number_of_nodes, &matrix_entries, m_number_of_threads);
+	if (mass_entries.size() != 0)
+		m_mass_matrix.setFromTriplets(m_number_of_nodes, m_number_of_nodes, &mass_entries, m_number_of_threads);
+
+	if (m_profiler != nullptr)
+		m_profiler->endPhase();
+
+	return !unknown_condition;
+}
+
+// The contributions of the boundary faces are listed by node in face order with one counting pass. Every
+// thread then sums the lists of its range of nodes, so each node is summed in the same order for any number of threads
+void Solver::addBoundaryVectors() {
+	unsigned int number_of_faces = m_data_loader->getBoundaryFaceCount();
+	const array<unsigned int, NODES_PER_ELEMENT>* current_elem_nodes_id;
+	vector<unsigned int> node_ptr(m_number_of_nodes + 1, 0);
+	vector<unsigned int> positions;
+	vector<unsigned int> contributions(number_of_faces * NODES_PER_ELEMENT);
+
+	for (unsigned int i = 0; i < number_of_faces; ++i) {
+		current_elem_nodes_id = m_data_loader->getElement(m_data_loader->getBoundaryFace(i)->element_id)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			++node_ptr[current_elem_nodes_id->at(k) + 1];
+	}
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i)
+		node_ptr[i + 1] += node_ptr[i];
+
+	positions.assign(node_ptr.begin(), node_ptr.end() - 1);
+	for (unsigned int i = 0; i < number_of_faces; ++i) {
+		current_elem_nodes_id = m_data_loader->getElement(m_data_loader->getBoundaryFace(i)->element_id)->getNodesId();
+		for (unsigned int k = 0; k < NODES_PER_ELEMENT; ++k)
+			contributions[positions[current_elem_nodes_id->at(k)]++] = i * NODES_PER_ELEMENT + k;
+	}
+
+	parallelFor(0, m_number_of_nodes, m_number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i)
+			for (unsigned int j = node_ptr[i]; j < node_ptr[i + 1]; ++j)
+				m_global_vector(i) += m_boundary_vectors[contributions[j] / NODES_PER_ELEMENT][contributions[j] % NODES_PER_ELEMENT];
+	});
+}
+
+bool Solver::setGlobalArrays() {
+	double heat_conduction_coeff = m_data_loader->getHeatConductionCoeff();
+	array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT> local_numeration;
+	map<unsigned int, double> nodes_with_const_temp;
+	vector<map<unsigned int, double>> load_case_temps(m_data_loader->getLoadCaseCount());
+	bool is_assembled = true;
+
+	m_global_vector.setZero(m_number_of_nodes);
+
+	if (m_solver_type == MATRIX_FREE_SOLVER)
+		return setMatrixFreeArrays();
+
+	// the transient explicit matrix loses its symmetry and the other preconditioners need both triangles
+	if (m_storage_type == UPPER_STORAGE && (m_analysis_type == TRANSIENT_ANALYSIS ||
+		(m_solver_type == PCG_SOLVER && m_preconditioner_type != JACOBI_PRECONDITIONER))) {
+		cout << "Error while constructing global arrays. Upper storage supports only steady analysis with the cholesky "
+			"solver or the jacobi preconditioner!" << endl;
+		return false;
+	}
+
+	FiniteElement::setupLocalNumeration(&local_numeration);
+	m_condensed_ids.clear();
+
+	// the stiffness matrix and the scatter map do not depend on the heat conduction, so a new steady assembly
+	// of the same mesh only scales the stored stiffness matrix. The boundary arrays follow the surface
+	// conditions and are computed again every time
+	if (m_assembly_type == TRIPLET_ASSEMBLY) {
+		m_boundary_vectors.resize(m_data_loader->getBoundaryFaceCount());
+		m_face_matrices.resize(m_data_loader->getBoundaryFaceCount());
+		is_assembled = assembleTriplets(&local_numeration, heat_conduction_coeff);
+	}
+	else if (m_analysis_type == TRANSIENT_ANALYSIS || m_scatter_map.size() != m_data_loader->getElementCount() ||
+		m_stiffness_matrix.getStorageType() != m_storage_type) {
+		m_boundary_vectors.resize(m_data_loader->getBoundaryFaceCount());
+		m_face_matrices.resize(m_data_loader->getBoundaryFaceCount());
+		is_assembled = assembleColored(&local_numeration);
+	}
+	else {
+		cout << "Reusing element stiffness of the global matrix..." << endl << endl;
+		is_assembled = assembleBoundaryFaces(&local_numeration);
+	}
+
+	if (!is_assembled) {
+		cout << "Error while constructing global arrays. Unknown boundary condition type!" << endl;
+		return false;
+	}
+
+	if (m_assembly_type == COLORED_ASSEMBLY)
+		scaleStiffnessMatrix(heat_conduction_coeff);
+
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("boundary vector");
+
+	collectConstantTemps(-1, &nodes_with_const_temp);
+
+	addBoundaryVectors();
+
+	if (m_profiler != nullptr)
+		m_profiler->endPhase();
+
+	if (load_case_temps.size() != 0) {
+		if (m_profiler != nullptr)
+			m_profiler->beginPhase("load case vectors");
+
+		cout << "Calculating global vectors of " << load_case_temps.size() << " load cases..." << endl << endl;
+
+		m_load_case_vectors.setZero(m_number_of_nodes, load_case_temps.size());
+		parallelFor(0, load_case_temps.size(), m_number_of_threads,
+			[&](unsigned int, unsigned int begin, unsigned int end) {
+				for (unsigned int i = begin; i < end; ++i)
+					assembleLoadCaseVector(i, &local_numeration, &load_case_temps.at(i));
+			});
+
+		if (m_profiler != nullptr)
+			m_profiler->endPhase();
+	}
+
+	if (m_analysis_type == TRANSIENT_ANALYSIS)
+		prepareTransient(&nodes_with_const_temp);
+
+	if (nodes_with_const_temp.size() != 0) {
+		cout << "Applying constant temperature conditions..." << endl << endl;
+		if (load_case_temps.size() != 0 && m_dirichlet_mode != PENALTY_DIRICHLET)
+			applyConstantTempCondToLoadCases(&nodes_with_const_temp, &load_case_temps);
+
+		// the transient scheme keeps all nodes, its explicit matrix is built for the full system
+		if (m_dirichlet_mode == CONDENSATION_DIRICHLET && m_analysis_type == STEADY_ANALYSIS &&
+			nodes_with_const_temp.size() < m_number_of_nodes)
+			condenseConstantTempCond(&nodes_with_const_temp, &load_case_temps);
+		else if (m_dirichlet_mode == PENALTY_DIRICHLET)
+			applyConstantTempPenalty(&nodes_with_const_temp, &load_case_temps);
+		else
+			applyConstantTempCond(&nodes_with_const_temp);
+	}
+
+	cout << "Global matrix and global vector are done. Global matrix consists of zeros at " <<
+		100 - (double)m_global_matrix.getNonZeroCount() / ((double)m_global_matrix.getRowCount() * (double)m_global_matrix.getRowCount()) * 100 << " persent" << endl << endl;
+
+	if (m_profiler != nullptr) {
+		m_profiler->setCounter("nodes", m_number_of_nodes);
+		m_profiler->setCounter("unknowns", m_global_matrix.getRowCount());
+		m_profiler->setCounter("elements", m_data_loader->getElementCount());
+		m_profiler->setCounter("boundary_faces", m_data_loader->getBoundaryFaceCount());
+		m_profiler->setCounter("threads", m_number_of_threads);
+		m_profiler->setCounter("nnz_a", m_global_matrix.getNonZeroCount());
+	}
+
+	return true;
+}
+
+// The fill-reducing ordering and the elimination tree depend only on the pattern, so they are
+// kept between solves and recomputed only when the pattern of the global matrix changes
+bool Solver::factorizeCholesky() {
+	ProfilerScope scope(m_profiler, "factorization");
+	bool is_same_pattern = m_analysis_count != 0 && *m_global_matrix.getRowPtr() == m_analyzed_row_ptr &&
+		*m_global_matrix.getColIds() == m_analyzed_col_ids;
+
+	if (!is_same_pattern) {
+		if (m_profiler != nullptr)
+			m_profiler->beginPhase("symbolic analysis");
+		m_cholesky.analyzePattern(m_global_matrix.getEigenMap());
+		m_analyzed_row_ptr = *m_global_matrix.getRowPtr();
+		m_analyzed_col_ids = *m_global_matrix.getColIds();
+		++m_analysis_count;
+		if (m_profiler != nullptr)
+			m_profiler->endPhase();
+	}
+	else
+		cout << "Reusing symbolic analysis of the global matrix..." << endl << endl;
+
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("numeric factorization");
+	m_cholesky.factorize(m_global_matrix.getEigenMap());
+	m_global_matrix.clear();
+	++m_factorization_count;
+	if (m_profiler != nullptr)
+		m_profiler->endPhase();
+
+	if (m_cholesky.info() != Eigen::Success) {
+		cout << "Error while solving the system!" << endl << endl;
+		return false;
+	}
+
+	if (m_profiler != nullptr) {
+		m_profiler->setCounter("nnz_l", m_cholesky.matrixL().nestedExpression().nonZeros());
+		m_profiler->setCounter("symbolic_analyses", m_analysis_count);
+		m_profiler->setCounter("numeric_factorizations", m_factorization_count);
+	}
+
+	return true;
+}
+
+bool Solver::solveCholesky(const Eigen::VectorXd* b) {
+	if (!factorizeCholesky())
+		return false;
+
+	ProfilerScope scope(m_profiler, "triangular solve");
+	m_result = m_cholesky.solve(*b);
+	if (m_cholesky.info() != Eigen::Success) {
+		cout << "Error while solving the system!" << endl << endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool Solver::solvePcg(const Eigen::VectorXd* b) {
+	JacobiPreconditioner jacobi_preconditioner;
+	IncompleteCholeskyPreconditioner incomplete_cholesky_preconditioner;
+	SsorPreconditioner ssor_preconditioner;
+	AmgPreconditioner amg_preconditioner;
+	Preconditioner* preconditioner;
+	const LinearOperator* matrix = &m_global_matrix;
+	PcgSolver solver;
+	bool is_initialized, is_converged;
+
+	// without the assembled matrix only its diagonal is known, so Jacobi is the one preconditioner left
+	if (m_solver_type == MATRIX_FREE_SOLVER) {
+		matrix = &m_matrix_free;
+		preconditioner = &jacobi_preconditioner;
+	}
+
+	else {
+		switch (m_preconditioner_type) {
+		case JACOBI_PRECONDITIONER:
+			preconditioner = &jacobi_preconditioner;
+			break;
+		case INCOMPLETE_CHOLESKY_PRECONDITIONER:
+			preconditioner = &incomplete_cholesky_preconditioner;
+			break;
+		case SSOR_PRECONDITIONER:
+			preconditioner = &ssor_preconditioner;
+			break;
+		case AMG_PRECONDITIONER:
+			amg_preconditioner.setSmootherType(m_smoother_type);
+			amg_preconditioner.setThreadCount(m_number_of_threads);
+			preconditioner = &amg_preconditioner;
+			break;
+		default:
+			cout << "Unknown preconditioner type!" << endl << endl;
+			return false;
+		}
+	}
+
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("preconditioner setup");
+	if (m_solver_type == MATRIX_FREE_SOLVER)
+		is_initialized = jacobi_preconditioner.initDiagonal(m_matrix_free.getDiagonal());
+	else
+		is_initialized = preconditioner->init(&m_global_matrix);
+	if (m_profiler != nullptr)
+		m_profiler->endPhase();
+
+	if (!is_initialized) {
+		cout << "Error while building the preconditioner!" << endl << endl;
+		return false;
+	}
+
+	solver.setTolerance(m_tolerance);
+	solver.setMaxIterations(m_max_iterations);
+	solver.setThreadCount(m_number_of_threads);
+
+	if (m_profiler != nullptr)
+		m_profiler->beginPhase("conjugate gradient");
+	is_converged = solver.solve(matrix, preconditioner, b, &m_result);
+	m_iteration_count = solver.getIterationCount();
+	m_residual = solver.getResidual();
+	m_global_matrix.clear();
+	m_matrix_free.clear();
+	if (m_profiler != nullptr) {
+		m_profiler->endPhase();
+		m_profiler->setCounter("iterations", m_iteration_count);
+		m_profiler->setCounter("residual", m_residual);
+	}
+
+	cout << "Conjugate gradient method made " << m_iteration_count << " iterations, relative residual is " << m_residual << endl << endl;
+
+	if (!is_converged) {
+		cout << "Error while solving the system! Conjugate gradient method did not converge" << endl << endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool Solver::solveTransient(const Eigen::VectorXd* b) {
+	Eigen::VectorXd temperature = m_initial_state;
+	Eigen::VectorXd rhs;
+
+	if (!factorizeCholesky())
+		return false;
+
+	cout << "Making " << m_number_of_steps << " time steps of " << m_time_step << " with theta = " << m_theta << "..." << endl << endl;
+
+	m_series_times.clear();
+	m_series_states.clear();
+	m_series_times.push_back(0.);
+	m_series_states.push_back(temperature);
+
+	ProfilerScope scope(m_profiler, "time stepping");
+
+	// the factorization is reused, so every step is one product and two triangular solves
+	for (unsigned int step = 1; step <= m_number_of_steps; ++step) {
+		m_explicit_matrix.multiply(&temperature, &rhs, m_number_of_threads);
+		rhs += *b;
+
+		temperature = m_cholesky.solve(rhs);
+		if (m_cholesky.info() != Eigen::Success) {
+			cout << "Error while solving the system at time step " << step << "!" << endl << endl;
+			return false;
+		}
+
+		if (step % m_output_interval == 0 || step == m_number_of_steps) {
+			m_series_times.push_back(step * m_time_step);
+			m_series_states.push_back(temperature);
+		}
+	}
+
+	m_explicit_matrix.clear();
+	m_result = temperature;
+
+	if (m_profiler != nullptr)
+		m_profiler->setCounter("time_steps", m_number_of_steps);
+
+	return true;
+}
+
+// The base conditions and all load cases are solved as one block against a single factorization
+bool Solver::solveLoadCases(const Eigen::VectorXd* b) {
+	unsigned int number_of_cases = m_load_case_vectors.cols();
+
+	if (!factorizeCholesky())
+		return false;
+
+	ProfilerScope scope(m_profiler, "triangular solve");
+
+	cout << "Solving " << number_of_cases << " load cases together with the base conditions..." << endl << endl;
+
+	m_load_case_results.resize(b->size(), number_of_cases + 1);
+	m_load_case_results.col(0) = *b;
+	m_load_case_results.rightCols(number_of_cases) = m_load_case_vectors;
+	m_load_case_vectors.resize(0, 0);
+
+	solveLoadCaseBlock(&m_load_case_results);
+	m_result = m_load_case_results.col(0);
+
+	if (m_profiler != nullptr)
+		m_profiler->setCounter("load_cases", number_of_cases);
+
+	return true;
+}
+
+// Eigen solves a block of right-hand sides one column after another and reads the factor once per column.
+// Here every entry of L is read once per thread and applied to a whole row slice of the block
+void Solver::solveLoadCaseBlock(LoadCaseBlock* block) const {
+	const Eigen::SparseMatrix<double>* factor = &m_cholesky.matrixL().nestedExpression();
+	LoadCaseBlock x = m_cholesky.permutationP() * (*block);
+
+	parallelFor(0, x.cols(), m_number_of_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+		unsigned int size = end - begin;
+		double diagonal;
+
+		for (int j = 0; j < factor->outerSize(); ++j) {
+			Eigen::SparseMatrix<double>::InnerIterator it(*factor, j);
+			x.row(j).segment(begin, size) /= it.value();
+			for (++it; it; ++it)
+				x.row(it.index()).segment(begin, size) -= x.row(j).segment(begin, size) * it.value();
+		}
+
+		for (int j = factor->outerSize() - 1; j >= 0; --j) {
+			Eigen::SparseMatrix<double>::InnerIterator it(*factor, j);
+			diagonal = it.value();
+			for (++it; it; ++it)
+				x.row(j).segment(begin, size) -= x.row(it.index()).segment(begin, size) * it.value();
+			x.row(j).segment(begin, size) /= diagonal;
+		}
+	});
+
+	*block = m_cholesky.permutationPinv() * x;
+}
+
+bool Solver::solve() {
+	Eigen::VectorXd b;
+	bool is_solved;
+	m_result.resize(m_number_of_nodes);
+
+	m_max_temperature = DBL_MIN;
+	m_min_temperature = DBL_MAX;
+
+	cout << "Solving the system..." << endl << endl;
+
+	b.swap(m_global_vector);
+
+	if (m_condensed_ids.size() != 0)
+		condenseVector(&b);
+
+	if (m_analysis_type == TRANSIENT_ANALYSIS)
+		is_solved = solveTransient(&b);
+
+	else if (m_load_case_vectors.cols() != 0)
+		is_solved = solveLoadCases(&b);
+
+	else if (m_solver_type == PCG_SOLVER || m_solver_type == MATRIX_FREE_SOLVER)
+		is_solved = solvePcg(&b);
+
+	else
+		is_solved = solveCholesky(&b);
+
+	if (!is_solved)
+		return false;
+
+	if (m_condensed_ids.size() != 0)
+		expandCondensedResult();
+
+	cout << "Task is solved!" << endl << endl;
+
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i) {
+		if (m_result(i) > m_max_temperature)
+			m_max_temperature = m_result(i);
+
+		if (m_result(i) < m_min_temperature)
+			m_min_temperature = m_result(i);
+	}
+
+	return true;
+}
+
+double Solver::getTemperatureAtNode(unsigned int  i) const
+{
+	if (i > m_number_of_nodes || i < 0)
+		return DBL_MIN;
+
+	else
+		return m_result(i);
+}
+
+unsigned int  Solver::getNodeCount() const {
+	return m_number_of_nodes;
+}
+
+double Solver::getMaxTemperature() const {
+	return m_max_temperature;
+}
+
+double Solver::getMinTemperature() const {
+	return m_min_temperature;
+}
+
+unsigned int Solver::getIterationCount() const {
+	return m_iteration_count;
+}
+
+double Solver::getResidual() const {
+	return m_residual;
+}
+
+unsigned int Solver::getAnalysisCount() const {
+	return m_analysis_count;
+}
+
+unsigned int Solver::getFactorizationCount() const {
+	return m_factorization_count;
+}
+
+AnalysisType Solver::getAnalysisType() const {
+	return m_analysis_type;
+}
+
+unsigned int Solver::getLoadCaseCount() const {
+	return m_load_case_results.cols() == 0 ? 0 : m_load_case_results.cols() - 1;
+}
+
+const LoadCaseBlock* Solver::getLoadCaseResults() const {
+	return &m_load_case_results;
+}
+
+unsigned int Solver::getTimeSeriesSize() const {
+	return m_series_times.size();
+}
+
+double Solver::getTimeSeriesTime(unsigned int id) const {
+	return m_series_times.at(id);
+}
+
+const Eigen::VectorXd* Solver::getTimeSeriesState(unsigned int id) const {
+	return &(m_series_states.at(id));
+}
+
+void Solver::printTemperature() const {
+	for (unsigned int i = 0; i < m_number_of_nodes; ++i)
+		cout << "Temperature at node number " << i << " is " << m_result(i) << endl;
+
+	cout << endl;
+}
+
+void Solver::heatFlowCond(array<double, NODES_PER_ELEMENT>* local_vector, const array<unsigned int, NODES_PER_EDGE>* local_numeration,
+	const FiniteElement* elem, const Edge* edge, const HeatFlowCondition* condition) const {
+
+	const array<double, COORDS_PER_NODE>* edge_center = edge->getCenter();
+	double edge_square = edge->getSquare();
+	double heat_flow = condition->getFlow();
+	unsigned int  current_node_local_id;
+	double coeff;
+	const array<double, NODES_PER_ELEMENT>* coeffs_a = elem->getCoeffsA();
+	const array<double, NODES_PER_ELEMENT>* coeffs_b = elem->getCoeffsB();
+	const array<double, NODES_PER_ELEMENT>* coeffs_c = elem->getCoeffsC();
+	const array<double, NODES_PER_ELEMENT>* coeffs_d = elem->getCoeffsD();
+	array<double, NODES_PER_ELEMENT> center_values;
+	array<unsigned int, NODES_PER_EDGE>::const_iterator local_numeration_iter;
+
+	center_values.fill(0.);
+
+	for (local_numeration_iter = local_numeration->begin(); local_numeration_iter != local_numeration->end(); local_numeration_iter++) {
+		current_node_local_id = *local_numeration_iter;
+		center_values.at(current_node_local_id) = coeffs_a->at(current_node_local_id);
+		center_values.at(current_node_local_id) += edge_center->at(0) * coeffs_b->at(current_node_local_id);
+		center_values.at(current_node_local_id) += edge_center->at(1) * coeffs_c->at(current_node_local_id);
+		center_values.at(current_node_local_id) += edge_center->at(2) * coeffs_d->at(current_node_local_id);
+	}
+
+	coeff = heat_flow * edge_square;
+
+	for (local_numeration_iter = local_numeration->begin(); local_numeration_iter != local_numeration->end(); local_numeration_iter++) {
+		current_node_local_id = *local_numeration_iter;
+		local_vector->at(current_node_local_id) -= center_values.at(current_node_local_id) * coeff;
+	}
+}
+
+void Solver::envirinmentHeatExchangeCond(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
+	array<double, NODES_PER_ELEMENT>* local_vector,
+	const array<unsigned int, NODES_PER_EDGE>* local_numeration,
+	const FiniteElement* elem, const Edge* edge,
+	const EnvironmentHeatExchangeCondition* condition) const {
+
+	double edge_square = edge->getSquare();
+	double exchange_coeff = condition->getEchangeCoeff();
+	unsigned int  current_node_local_id_1, current_node_local_id_2;
+	double coeff;
+	const array<double, COORDS_PER_NODE>* point_a = edge->getPointA();
+	const array<double, COORDS_PER_NODE>* point_b = edge->getPointB();
+	const array<double, COORDS_PER_NODE>* point_c = edge->getPointC();
+	const array<double, NODES_PER_ELEMENT>* coeffs_a = elem->getCoeffsA();
+	const array<double, NODES_PER_ELEMENT>* coeffs_b = elem->getCoeffsB();
+	const array<double, NODES_PER_ELEMENT>* coeffs_c = elem->getCoeffsC();
+	const array<double, NODES_PER_ELEMENT>* coeffs_d = elem->getCoeffsD();
+	array<double, NODES_PER_ELEMENT> center_values;
+	array<double, NODES_PER_ELEMENT> point_a_values;
+	array<double, NODES_PER_ELEMENT> point_b_values;
+	array<double, NODES_PER_ELEMENT> point_c_values;
+	array<unsigned int, NODES_PER_EDGE>::const_iterator local_numeration_iter_1, local_numeration_iter_2;
+
+	envirinmentHeatExchangeVector(local_vector, local_numeration, elem, edge, condition);
+
+	center_values.fill(0.);
+	point_a_values.fill(0.);
+	point_b_values.fill(0.);
+	point_c_values.fill(0.);
+
+	for (local_numeration_iter_1 = local_numeration->begin(); local_numeration_iter_1 != local_numeration->end(); ++local_numeration_iter_1) {
+		current_node_local_id_1 = *local_numeration_iter_1;
+
+		point_a_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
+		point_a_values.at(current_node_local_id_1) += coeffs_b->at(current_node_local_id_1) * point_a->at(0);
+		point_a_values.at(current_node_local_id_1) += coeffs_c->at(current_node_local_id_1) * point_a->at(1);
+		point_a_values.at(current_node_local_id_1) += coeffs_d->at(current_node_local_id_1) * point_a->at(2);
+
+		point_b_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
+		point_b_values.at(current_node_local_id_1) += coeffs_b->at(current_node_local_id_1) * point_b->at(0);
+		point_b_values.at(current_node_local_id_1) += coeffs_c->at(current_node_local_id_1) * point_b->at(1);
+		point_b_values.at(current_node_local_id_1) += coeffs_d->at(current_node_local_id_1) * point_b->at(2);
+
+		point_c_values.at(current_node_local_id_1) = coeffs_a->at(current_node_local_id_1);
+		point_c_values.at(current_node_local_id_1) += coeffs_b->at(current_node_local_id_1) * point_c->at(0);
+		point_c_values.at(current_node_local_id_1) += coeffs_c->at(current_node_local_id_1) * point_c->at(1);
+		point_c_values.at(current_node_local_id_1) += coeffs_d->at(current_node_local_id_1) * point_c->at(2);
+
+		center_values.at(current_node_local_id_1) = point_a_values.at(current_node_local_id_1);
+		center_values.at(current_node_local_id_1) += point_b_values.at(current_node_local_id_1);
+		center_values.at(current_node_local_id_1) += point_c_values.at(current_node_local_id_1);
+		center_values.at(current_node_local_id_1) /= NODES_PER_EDGE;
+	}
+
+	coeff = edge_square * exchange_coeff;
+
+	for (local_numeration_iter_1 = local_numeration->begin(); local_numeration_iter_1 != local_numeration->end(); ++local_numeration_iter_1) {
+		current_node_local_id_1 = *local_numeration_iter_1;
+
+		for (local_numeration_iter_2 = local_numeration->begin(); local_numeration_iter_2 != local_numeration->end(); ++local_numeration_iter_2) {
+			current_node_local_id_2 = *local_numeration_iter_2;
+
+			local_matrix->at(current_node_local_id_1).at(current_node_local_id_2) +=
+				center_values.at(current_node_local_id_1) * center_values.at(current_node_local_id_2) * coeff;
+		}
+	}
+}
+
+void Solver::setToGlobalMatrix(unsigned int  i, unsigned int  j, double value) {
+	m_global_matrix.setValue(i, j, value);
+}
+
+// An entry of an upper matrix is moved to the stored triangle
+CooEntry Solver::getTriplet(unsigned int i, unsigned int j, double value) const {
+	if (m_storage_type == UPPER_STORAGE && i > j)
+		return CooEntry{ j, i, value };
+
+	return CooEntry{ i, j, value };
+}
+
+void Solver::addToGlobalMatrix(unsigned int  i, unsigned int  j, double value) {
+	if (value != 0)
+		m_global_matrix.addValue(i, j, value);
+}
+
+double Solver::getFromGlobalMatrix(unsigned int  i, unsigned int  j) const {
+	return m_global_matrix.getValue(i, j);
+}
+
+void Solver::setToGlobalVector(unsigned int  i, double value) {
+	m_global_vector(i) = value;
+}
+
+void Solver::addToGlobalVector(unsigned int  i, double value) {
+	m_global_vector(i) += value;
+}
+
+double Solver::getFromGlobalVector(unsigned int  i) const {
+	return m_global_vector(i);
+}
+
+void Solver::envirinmentHeatExchangeVector(array<double, NODES_PER_ELEMENT>* local_vector,
+	const array<unsigned int, NODES_PER_EDGE>* local_numeration,
+	const FiniteElement* elem, const Edge* edge,
+	const EnvironmentHeatExchangeCondition* condition) const {
+
+	double edge_square = edge->getSquare();
+	double exchange_coeff = condition->getEchangeCoeff();
+	double invironment_temp = condition->getEnvironmentTemp();
+	unsigned int  current_node_local_id;
+	double coeff;
+	const array<double, COORDS_PER_NODE>* edge_center = edge->getCenter();
+	const array<double, NODES_PER_ELEMENT>* coeffs_a = elem->getCoeffsA();
+	const array<double, NODES_PER_ELEMENT>* coeffs_b = elem->getCoeffsB();
+	const array<double, NODES_PER_ELEMENT>* coeffs_c = elem->getCoeffsC();
+	const array<double, NODES_PER_ELEMENT>* coeffs_d = elem->getCoeffsD();
+	array<double, NODES_PER_ELEMENT> center_values;
+	array<unsigned int, NODES_PER_EDGE>::const_iterator local_numeration_iter;
+
+	center_values.fill(0.);
+
+	for (local_numeration_iter = local_numeration->begin(); local_numeration_iter != local_numeration->end(); ++local_numeration_iter) {
+		current_node_local_id = *local_numeration_iter;
+		center_values.at(current_node_local_id) = coeffs_a->at(current_node_local_id);
+		center_values.at(current_node_local_id) += edge_center->at(0) * coeffs_b->at(current_node_local_id);
+		center_values.at(current_node_local_id) += edge_center->at(1) * coeffs_c->at(current_node_local_id);
+		center_values.at(current_node_local_id) += edge_center->at(2) * coeffs_d->at(current_node_local_id);
+	}
+
+	coeff = exchange_coeff * invironment_temp * edge_square;
+
+	for (local_numeration_iter = local_numeration->begin(); local_numeration_iter != local_numeration->end(); ++local_numeration_iter) {
+		current_node_local_id = *local_numeration_iter;
+		local_vector->at(current_node_local_id) += center_values.at(current_node_local_id) * coeff;
+	}
+}
@@ -1,64 +1,196 @@
-#pragma once
-#include <map>
-#include <cmath>
-#include <iostream>
-#include "./lib/eigen/SparseCore"
-#include "./lib/eigen/SparseLU"
-#include "./lib/eigen/Dense"
-#include "./lib/eigen/SparseCholesky"
-#include "FiniteElement.h"
-#include "Edge.h"
-#include "Surface.h"
-#include "Condition.h"
-#include "DataLoader.h"
-#include "Defines.h"
-
-using namespace std;
-
-class Solver
-{
-private:
-	unsigned int m_number_of_nodes;
-	double m_max_temperature;
-	double m_min_temperature;
-	const DataLoader* m_data_loader;
-	map<pair<unsigned int, unsigned int>, double> m_global_matrix;
-	map<unsigned int, double> m_global_vector;
-	Eigen::VectorXd m_result;
-
-private:
-	void setupLocalNumeration(array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration) const;
-	void setToGlobalMatrix(unsigned int i, unsigned int j, double value);
-	void addToGlobalMatrix(unsigned int i, unsigned int j, double value);
-	double getFromGlobalMatrix(unsigned int i, unsigned int j) const;
-	void setToGlobalVector(unsigned int i, double value);
-	void addToGlobalVector(unsigned int i, double value);
-	double getFromGlobalVector(unsigned int i) const;
-	void setupBoundaryEdges(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
-							const array<unsigned int, NODES_PER_ELEMENT>* nodes_id,
-							array<const Edge*, NODES_PER_ELEMENT>* boundary_edges) const;
-	void initLocalMatrix(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
-						 const FiniteElement* elem, double heat_conduction_coeff) const;
-	void initLocalVector(array<double, NODES_PER_ELEMENT>* local_vector) const;
-	void applyConstantTempCond(const map<unsigned int, double>* nodes_with_const_temp);
-	void heatFlowCond(array<double, NODES_PER_ELEMENT>* local_vector,
-					  const array<unsigned int, NODES_PER_EDGE>* local_numeration,
-					  const FiniteElement* elem, const Edge* edge,
-					  const HeatFlowCondition* condition) const;
-	void envirinmentHeatExchangeCond(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
-									 array<double, NODES_PER_ELEMENT>* local_vector,
-									 const array<unsigned int, NODES_PER_EDGE>* local_numeration,
-									 const FiniteElement* elem,
-									 const Edge* edge,
-									 const EnvironmentHeatExchangeCondition* condition) const;
-
-public:
-	explicit Solver(const DataLoader* data_loader);
-	bool setGlobalArrays();
-	bool solve();
-	double getTemperatureAtNode(unsigned int i) const;
-	unsigned int getNodeCount() const;
-	double getMaxTemperature() const;
-	double getMinTemperature() const;
-	void printTemperature() const;
+#pragma once
+#include <map>
+#include <cmath>
+#include <cfloat>
+#include <iostream>
+#include <atomic>
+#include "./lib/eigen/SparseCore"
+#include "./lib/eigen/SparseLU"
+#include "./lib/eigen/Dense"
+#include "./lib/eigen/SparseCholesky"
+#include "FiniteElement.h"
+#include "Edge.h"
+#include "Surface.h"
+#include "Condition.h"
+#include "DataLoader.h"
+#include "CsrMatrix.h"
+#include "ElementColoring.h"
+#include "ElementStore.h"
+#include "Parallel.h"
+#include "Preconditioner.h"
+#include "PcgSolver.h"
+#include "MatrixFreeOperator.h"
+#include "AmgPreconditioner.h"
+#include "Profiler.h"
+#include "Defines.h"
+
+using namespace std;
+
+enum SolverType {
+	CHOLESKY_SOLVER,
+	PCG_SOLVER,
+	MATRIX_FREE_SOLVER,
+};
+
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> LoadCaseBlock;
+
+enum DirichletMode {
+	ELIMINATION_DIRICHLET,
+	CONDENSATION_DIRICHLET,
+	LIFTING_DIRICHLET,
+	PENALTY_DIRICHLET,
+};
+
+enum AssemblyType {
+	COLORED_ASSEMBLY,
+	TRIPLET_ASSEMBLY,
+};
+
+enum AnalysisType {
+	STEADY_ANALYSIS,
+	TRANSIENT_ANALYSIS,
+};
+
+class Solver
+{
+private:
+	unsigned int m_number_of_nodes;
+	unsigned int m_number_of_threads;
+	SolverType m_solver_type;
+	AnalysisType m_analysis_type;
+	AssemblyType m_assembly_type;
+	StorageType m_storage_type;
+	DirichletMode m_dirichlet_mode;
+	PreconditionerType m_preconditioner_type;
+	SmootherType m_smoother_type;
+	double m_tolerance;
+	unsigned int m_max_iterations;
+	unsigned int m_iteration_count;
+	double m_residual;
+	double m_heat_capacity;
+	double m_time_step;
+	double m_theta;
+	double m_penalty_factor;
+	double m_initial_temperature;
+	unsigned int m_number_of_steps;
+	unsigned int m_output_interval;
+	double m_max_temperature;
+	double m_min_temperature;
+	const DataLoader* m_data_loader;
+	Profiler* m_profiler;
+	CsrMatrix m_global_matrix;
+	CsrMatrix m_stiffness_matrix;
+	vector<ElementOffsets> m_scatter_map;
+	vector<array<double, NODES_PER_ELEMENT>> m_boundary_vectors;
+	vector<array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>> m_face_matrices;
+	CsrMatrix m_mass_matrix;
+	CsrMatrix m_explicit_matrix;
+	MatrixFreeOperator m_matrix_free;
+	Eigen::VectorXd m_global_vector;
+	Eigen::VectorXd m_initial_state;
+	Eigen::VectorXd m_result;
+	vector<double> m_series_times;
+	vector<Eigen::VectorXd> m_series_states;
+	LoadCaseBlock m_load_case_vectors;
+	LoadCaseBlock m_load_case_results;
+	vector<int> m_condensed_ids;
+	LoadCaseBlock m_constrained_values;
+	Eigen::SimplicialLLT<SparseMatrixMap> m_cholesky;
+	vector<int> m_analyzed_row_ptr;
+	vector<int> m_analyzed_col_ids;
+	unsigned int m_analysis_count;
+	unsigned int m_factorization_count;
+
+private:
+	void setToGlobalMatrix(unsigned int i, unsigned int j, double value);
+	void addToGlobalMatrix(unsigned int i, unsigned int j, double value);
+	CooEntry getTriplet(unsigned int i, unsigned int j, double value) const;
+	double getFromGlobalMatrix(unsigned int i, unsigned int j) const;
+	void setToGlobalVector(unsigned int i, double value);
+	void addToGlobalVector(unsigned int i, double value);
+	double getFromGlobalVector(unsigned int i) const;
+	void initLocalVector(array<double, NODES_PER_ELEMENT>* local_vector) const;
+	void initLocalMassMatrix(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
+							 const FiniteElement* elem, double heat_capacity) const;
+	void prepareTransient(const map<unsigned int, double>* nodes_with_const_temp);
+	bool setBoundaryFaceArrays(unsigned int face_id, const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration);
+	bool assembleElements(const ElementColoring* coloring, const ElementStore* element_store, unsigned int begin, unsigned int end,
+						  const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
+						  double heat_conduction_coeff, vector<CooEntry>* matrix_entries, vector<CooEntry>* mass_entries);
+	bool assembleColored(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration);
+	bool assembleBoundaryFaces(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration);
+	void scaleStiffnessMatrix(double heat_conduction_coeff);
+	void addBoundaryVectors();
+	bool assembleTriplets(const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
+						  double heat_conduction_coeff);
+	bool setMatrixFreeArrays();
+	bool factorizeCholesky();
+	bool solveCholesky(const Eigen::VectorXd* b);
+	bool solvePcg(const Eigen::VectorXd* b);
+	bool solveTransient(const Eigen::VectorXd* b);
+	bool solveLoadCases(const Eigen::VectorXd* b);
+	void solveLoadCaseBlock(LoadCaseBlock* block) const;
+	void assembleLoadCaseVector(unsigned int case_id, const array<array<unsigned int, NODES_PER_EDGE>, EDGES_PER_ELEMENT>* local_numeration,
+								map<unsigned int, double>* nodes_with_const_temp);
+	void collectConstantTemps(int case_id, map<unsigned int, double>* nodes_with_const_temp) const;
+	void applyConstantTempCond(const map<unsigned int, double>* nodes_with_const_temp);
+	void applyConstantTempCondToLoadCases(const map<unsigned int, double>* nodes_with_const_temp,
+										  const vector<map<unsigned int, double>>* load_case_temps);
+	void condenseConstantTempCond(const map<unsigned int, double>* nodes_with_const_temp,
+								  const vector<map<unsigned int, double>>* load_case_temps);
+	void condenseVector(Eigen::VectorXd* vector) const;
+	void applyConstantTempPenalty(const map<unsigned int, double>* nodes_with_const_temp,
+								  const vector<map<unsigned int, double>>* load_case_temps);
+	void expandCondensedResult();
+	void heatFlowCond(array<double, NODES_PER_ELEMENT>* local_vector,
+					  const array<unsigned int, NODES_PER_EDGE>* local_numeration,
+					  const FiniteElement* elem, const Edge* edge,
+					  const HeatFlowCondition* condition) const;
+	void envirinmentHeatExchangeCond(array<array<double, NODES_PER_ELEMENT>, NODES_PER_ELEMENT>* local_matrix,
+									 array<double, NODES_PER_ELEMENT>* local_vector,
+									 const array<unsigned int, NODES_PER_EDGE>* local_numeration,
+									 const FiniteElement* elem,
+									 const Edge* edge,
+									 const EnvironmentHeatExchangeCondition* condition) const;
+	void envirinmentHeatExchangeVector(array<double, NODES_PER_ELEMENT>* local_vector,
+									   const array<unsigned int, NODES_PER_EDGE>* local_numeration,
+									   const FiniteElement* elem,
+									   const Edge* edge,
+									   const EnvironmentHeatExchangeCondition* condition) const;
+
+public:
+	explicit Solver(const DataLoader* data_loader);
+	void setThreadCount(unsigned int number_of_threads);
+	void setProfiler(Profiler* profiler);
+	void setSolverType(SolverType solver_type);
+	void setPreconditionerType(PreconditionerType preconditioner_type);
+	void setSmootherType(SmootherType smoother_type);
+	void setTolerance(double tolerance);
+	void setMaxIterations(unsigned int max_iterations);
+	void setAnalysisType(AnalysisType analysis_type);
+	void setAssemblyType(AssemblyType assembly_type);
+	void setStorageType(StorageType storage_type);
+	void setDirichletMode(DirichletMode dirichlet_mode);
+	void setPenaltyFactor(double penalty_factor);
+	void setHeatCapacity(double heat_capacity);
+	void setTimeStepping(double time_step, unsigned int number_of_steps, double theta);
+	void setInitialTemperature(double temperature);
+	void setOutputInterval(unsigned int output_interval);
+	bool setGlobalArrays();
+	bool solve();
+	double getTemperatureAtNode(unsigned int i) const;
+	unsigned int getNodeCount() const;
+	double getMaxTemperature() const;
+	double getMinTemperature() const;
+	unsigned int getIterationCount() const;
+	double getResidual() const;
+	unsigned int getAnalysisCount() const;
+	unsigned int getFactorizationCount() const;
+	AnalysisType getAnalysisType() const;
+	unsigned int getLoadCaseCount() const;
+	const LoadCaseBlock* getLoadCaseResults() const;
+	unsigned int getTimeSeriesSize() const;
+	double getTimeSeriesTime(unsigned int id) const;
+	const Eigen::VectorXd* getTimeSeriesState(unsigned int id) const;
+	void printTemperature() const;
 };
\ No newline at end of file
@@ -1,51 +1,407 @@
-#include <iostream>
-#include <conio.h>
-#include <string>
-#include "DataLoader.h"
-#include "Solver.h"
-#include "Exporter.h"
-
-using namespace std;
-
-int main(int argc, char* argv[]) {
-	string file_path;
-
-	if (argc != 2) {
-		cout << "This is a console application. You can use it from the command line or drag file and drop it on the application icon." << endl;
-		_getch();
-		return -1;
-	}
-
-	else
-		file_path = argv[1];
-
-	DataLoader data_loader(file_path);
-
-	if (!data_loader.loadData()) {
-		_getch();
-		return -1;
-	}
-
-	Solver solver(&data_loader);
-	if (!solver.setGlobalArrays()) {
-		_getch();
-		return -1;
-	}
-
-	data_loader.deleteSomeDataBeforeSolve();
-
-	if (!solver.solve()) {
-		_getch();
-		return -1;
-	}
-
-	Exporter exporter(&data_loader, &solver);
-	exporter.setExeFilePath(argv[0]);
-	exporter.generateJSFile("/webgl sources/solver.js");
-	exporter.genetateTxtFile("/result.txt");
-
-	cout << "Press a key to exit";
-
-	_getch();
-	return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <string>
+#include <limits>
+#ifdef _WIN32
+#include <conio.h>
+#endif
+#include "ConfigFile.h"
+#include "DataLoader.h"
+#include "Solver.h"
+#include "Exporter.h"
+#include "Profiler.h"
+#include "NodeOrdering.h"
+
+using namespace std;
+
+enum ExitStatus {
+	STATUS_OK = 0,
+	STATUS_WRONG_ARGUMENTS = 1,
+	STATUS_LOAD_ERROR = 2,
+	STATUS_ASSEMBLY_ERROR = 3,
+	STATUS_SOLVE_ERROR = 4,
+	STATUS_EXPORT_ERROR = 5,
+};
+
+void waitForKey() {
+#ifdef _WIN32
+	_getch();
+#else
+	cin.ignore(numeric_limits<streamsize>::max(), '\n');
+	cin.get();
+#endif
+}
+
+int finish(ExitStatus status, bool is_batch) {
+	if (is_batch)
+		return status;
+
+	waitForKey();
+
+	return status == STATUS_OK ? 0 : -1;
+}
+
+bool applyTransientConfig(const ConfigFile* config, Solver* solver) {
+	double density, heat_capacity, time_step, end_time;
+	double theta = DEFAULT_THETA;
+	double initial_temperature = 0;
+	unsigned int number_of_steps;
+	unsigned int output_interval = DEFAULT_OUTPUT_INTERVAL;
+
+	if (config->hasValue("", "load_cases")) {
+		cout << "Load cases can't be used with transient analysis" << endl;
+		return false;
+	}
+
+	if (!config->getDouble("", "density", &density) || density <= 0) {
+		cout << "Incorrect density in the config file" << endl;
+		return false;
+	}
+
+	if (!config->getDouble("", "heat_capacity", &heat_capacity) || heat_capacity <= 0) {
+		cout << "Incorrect heat_capacity in the config file" << endl;
+		return false;
+	}
+
+	if (!config->getDouble("", "time_step", &time_step) || time_step <= 0) {
+		cout << "Incorrect time_step in the config file" << endl;
+		return false;
+	}
+
+	if (config->hasValue("", "steps")) {
+		if (!config->getUnsigned("", "steps", &number_of_steps) || number_of_steps == 0) {
+			cout << "Incorrect steps in the config file" << endl;
+			return false;
+		}
+	}
+	else {
+		if (!config->getDouble("", "end_time", &end_time) || end_time < time_step) {
+			cout << "Incorrect end_time in the config file" << endl;
+			return false;
+		}
+		number_of_steps = (unsigned int)(end_time / time_step + 0.5);
+	}
+
+	if (config->hasValue("", "theta") && (!config->getDouble("", "theta", &theta) || theta < 0 || theta > 1)) {
+		cout << "Incorrect theta in the config file" << endl;
+		return false;
+	}
+
+	if (config->hasValue("", "initial_temperature") && !config->getDouble("", "initial_temperature", &initial_temperature)) {
+		cout << "Incorrect initial_temperature in the config file" << endl;
+		return false;
+	}
+
+	if (config->hasValue("", "output_interval") && (!config->getUnsigned("", "output_interval", &output_interval) || output_interval == 0)) {
+		cout << "Incorrect output_interval in the config file" << endl;
+		return false;
+	}
+
+	solver->setAnalysisType(TRANSIENT_ANALYSIS);
+	solver->setHeatCapacity(density * heat_capacity);
+	solver->setTimeStepping(time_step, number_of_steps, theta);
+	solver->setInitialTemperature(initial_temperature);
+	solver->setOutputInterval(output_interval);
+
+	return true;
+}
+
+bool applySolverConfig(const ConfigFile* config, Solver* solver) {
+	string value;
+	double tolerance, penalty_factor;
+	unsigned int number;
+
+	value = config->getString("", "solver", "cholesky");
+	if (value == "cholesky")
+		solver->setSolverType(CHOLESKY_SOLVER);
+	else if (value == "pcg")
+		solver->setSolverType(PCG_SOLVER);
+	else if (value == "matrix_free")
+		solver->setSolverType(MATRIX_FREE_SOLVER);
+	else {
+		cout << "Unknown solver \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	// the matrix-free operator applies the elements of a single steady system with eliminated constant temperatures
+	if (value == "matrix_free") {
+		if (config->getString("", "preconditioner", "jacobi") != "jacobi") {
+			cout << "The matrix_free solver supports only the jacobi preconditioner" << endl;
+			return false;
+		}
+
+		if (config->getString("", "dirichlet", "elimination") != "elimination") {
+			cout << "The matrix_free solver supports only the elimination dirichlet mode" << endl;
+			return false;
+		}
+
+		if (config->getString("", "analysis", "steady") != "steady" || config->hasValue("", "load_cases")) {
+			cout << "The matrix_free solver can't be used with transient analysis or load cases" << endl;
+			return false;
+		}
+	}
+
+	// the load cases are solved together against one factorization of the global matrix
+	if (value == "pcg" && config->getUnsigned("", "load_cases", &number) && number != 0) {
+		cout << "Load cases need the cholesky solver" << endl;
+		return false;
+	}
+
+	value = config->getString("", "preconditioner", "ic");
+	if (value == "jacobi")
+		solver->setPreconditionerType(JACOBI_PRECONDITIONER);
+	else if (value == "ic")
+		solver->setPreconditionerType(INCOMPLETE_CHOLESKY_PRECONDITIONER);
+	else if (value == "ssor")
+		solver->setPreconditionerType(SSOR_PRECONDITIONER);
+	else if (value == "amg")
+		solver->setPreconditionerType(AMG_PRECONDITIONER);
+	else {
+		cout << "Unknown preconditioner \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	value = config->getString("", "smoother", "chebyshev");
+	if (value == "jacobi")
+		solver->setSmootherType(JACOBI_SMOOTHER);
+	else if (value == "chebyshev")
+		solver->setSmootherType(CHEBYSHEV_SMOOTHER);
+	else {
+		cout << "Unknown smoother \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	if (config->hasValue("", "tolerance")) {
+		if (!config->getDouble("", "tolerance", &tolerance) || tolerance <= 0) {
+			cout << "Incorrect tolerance in the config file" << endl;
+			return false;
+		}
+		solver->setTolerance(tolerance);
+	}
+
+	if (config->hasValue("", "max_iterations")) {
+		if (!config->getUnsigned("", "max_iterations", &number) || number == 0) {
+			cout << "Incorrect max_iterations in the config file" << endl;
+			return false;
+		}
+		solver->setMaxIterations(number);
+	}
+
+	if (config->hasValue("", "threads")) {
+		if (!config->getUnsigned("", "threads", &number)) {
+			cout << "Incorrect threads in the config file" << endl;
+			return false;
+		}
+		solver->setThreadCount(number);
+	}
+
+	value = config->getString("", "assembly", "colored");
+	if (value == "colored")
+		solver->setAssemblyType(COLORED_ASSEMBLY);
+	else if (value == "triplet")
+		solver->setAssemblyType(TRIPLET_ASSEMBLY);
+	else {
+		cout << "Unknown assembly \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	value = config->getString("", "storage", "full");
+	if (value == "full")
+		solver->setStorageType(FULL_STORAGE);
+	else if (value == "upper")
+		solver->setStorageType(UPPER_STORAGE);
+	else {
+		cout << "Unknown storage \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	value = config->getString("", "dirichlet", "elimination");
+	if (value == "elimination")
+		solver->setDirichletMode(ELIMINATION_DIRICHLET);
+	else if (value == "condensation")
+		solver->setDirichletMode(CONDENSATION_DIRICHLET);
+	else if (value == "lifting")
+		solver->setDirichletMode(LIFTING_DIRICHLET);
+	else if (value == "penalty")
+		solver->setDirichletMode(PENALTY_DIRICHLET);
+	else {
+		cout << "Unknown dirichlet mode \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	// the penalty rows dominate the residual norm, so the conjugate gradient method would stop too early
+	if (value == "penalty" && config->getString("", "solver", "cholesky") == "pcg") {
+		cout << "The penalty dirichlet mode needs the cholesky solver, use lifting with pcg" << endl;
+		return false;
+	}
+
+	if (config->hasValue("", "penalty_factor")) {
+		if (!config->getDouble("", "penalty_factor", &penalty_factor) || penalty_factor <= 1) {
+			cout << "Incorrect penalty_factor in the config file" << endl;
+			return false;
+		}
+		solver->setPenaltyFactor(penalty_factor);
+	}
+
+	value = config->getString("", "analysis", "steady");
+	if (value == "steady")
+		solver->setAnalysisType(STEADY_ANALYSIS);
+	else if (value == "transient")
+		return applyTransientConfig(config, solver);
+	else {
+		cout << "Unknown analysis \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool applyNodeOrdering(const ConfigFile* config, DataLoader* data_loader, Profiler* profiler) {
+	string value = config->getString("", "node_ordering", "none");
+	NodeOrderingType ordering_type;
+	NodeOrdering ordering;
+	unsigned int bandwidth, new_bandwidth;
+	unsigned long long profile, new_profile;
+
+	if (value == "none")
+		return true;
+	else if (value == "rcm")
+		ordering_type = RCM_ORDERING;
+	else if (value == "hilbert")
+		ordering_type = HILBERT_ORDERING;
+	else if (value == "morton")
+		ordering_type = MORTON_ORDERING;
+	else {
+		cout << "Unknown node_ordering \"" << value << "\" in the config file" << endl;
+		return false;
+	}
+
+	ProfilerScope scope(profiler, "node ordering");
+
+	NodeOrdering::getEnvelope(data_loader, &bandwidth, &profile);
+	ordering.init(data_loader, ordering_type);
+	data_loader->renumberNodes(ordering.getNewIds());
+	NodeOrdering::getEnvelope(data_loader, &new_bandwidth, &new_profile);
+
+	cout << "Nodes renumbered in " << value << " order: bandwidth " << bandwidth << " -> " << new_bandwidth
+		<< ", profile " << profile << " -> " << new_profile << endl << endl;
+
+	return true;
+}
+
+bool writeProfile(const ConfigFile* config, const Profiler* profiler) {
+	bool is_written = true;
+
+	if (config->hasValue("", "profile_report"))
+		is_written = profiler->writeReport(config->getString("", "profile_report", "")) && is_written;
+
+	if (config->hasValue("", "profile_trace"))
+		is_written = profiler->writeChromeTrace(config->getString("", "profile_trace", "")) && is_written;
+
+	return is_written;
+}
+
+int main(int argc, char* argv[]) {
+	string file_path, cache_file_path, result_file;
+	ConfigFile config;
+	Profiler profiler;
+	Profiler* active_profiler = nullptr;
+	bool is_batch = argc == 3;
+	bool export_js = true;
+
+	if (argc != 2 && argc != 3) {
+		cout << "This is a console application. You can use it from the command line or drag file and drop it on the application icon." << endl
+			<< "Usage: " << argv[0] << " <mesh file> [config file]" << endl
+			<< "With a config file the boundary conditions are read from it and the program runs without any input." << endl;
+		return finish(STATUS_WRONG_ARGUMENTS, false);
+	}
+
+	file_path = argv[1];
+	cache_file_path = file_path + ".cache";
+	result_file = "result.txt";
+
+	if (is_batch) {
+		if (!config.load(argv[2]))
+			return finish(STATUS_WRONG_ARGUMENTS, is_batch);
+
+		cache_file_path = config.getString("", "mesh_cache", cache_file_path);
+		if (cache_file_path == "off")
+			cache_file_path = "";
+
+		result_file = config.getString("", "result_file", result_file);
+
+		export_js = false;
+		if (config.hasValue("", "export_js") && !config.getBool("", "export_js", &export_js)) {
+			cout << "Incorrect export_js in the config file" << endl;
+			return finish(STATUS_WRONG_ARGUMENTS, is_batch);
+		}
+
+		if (config.hasValue("", "profile_report") || config.hasValue("", "profile_trace"))
+			active_profiler = &profiler;
+	}
+
+	DataLoader data_loader(file_path);
+	data_loader.setMeshCachePath(cache_file_path);
+	data_loader.setProfiler(active_profiler);
+	if (is_batch)
+		data_loader.setConfig(&config);
+
+	if (active_profiler != nullptr)
+		active_profiler->beginPhase("load");
+	if (!data_loader.loadData())
+		return finish(STATUS_LOAD_ERROR, is_batch);
+	if (active_profiler != nullptr)
+		active_profiler->endPhase();
+
+	if (is_batch && !applyNodeOrdering(&config, &data_loader, active_profiler))
+		return finish(STATUS_WRONG_ARGUMENTS, is_batch);
+
+	Solver solver(&data_loader);
+	solver.setProfiler(active_profiler);
+	if (is_batch && !applySolverConfig(&config, &solver))
+		return finish(STATUS_WRONG_ARGUMENTS, is_batch);
+
+	if (active_profiler != nullptr)
+		active_profiler->beginPhase("assembly");
+	if (!solver.setGlobalArrays())
+		return finish(STATUS_ASSEMBLY_ERROR, is_batch);
+	if (active_profiler != nullptr)
+		active_profiler->endPhase();
+
+	data_loader.deleteSomeDataBeforeSolve();
+
+	if (active_profiler != nullptr)
+		active_profiler->beginPhase("solve");
+	if (!solver.solve())
+		return finish(STATUS_SOLVE_ERROR, is_batch);
+	if (active_profiler != nullptr)
+		active_profiler->endPhase();
+
+	Exporter exporter(&data_loader, &solver);
+	exporter.setExeFilePath(argv[0]);
+	if (is_batch)
+		exporter.setOutputDirectory(config.getString("", "output_directory", "."));
+
+	if (active_profiler != nullptr)
+		active_profiler->beginPhase("export");
+	if (export_js && !exporter.generateJSFile("/webgl sources/solver.js") && is_batch)
+		return finish(STATUS_EXPORT_ERROR, is_batch);
+
+	if (!exporter.genetateTxtFile("/" + result_file))
+		return finish(STATUS_EXPORT_ERROR, is_batch);
+
+	if (solver.getAnalysisType() == TRANSIENT_ANALYSIS && !exporter.generateTimeSeriesFiles("/" + result_file))
+		return finish(STATUS_EXPORT_ERROR, is_batch);
+
+	if (solver.getLoadCaseCount() != 0 && !exporter.generateLoadCaseFiles("/" + result_file))
+		return finish(STATUS_EXPORT_ERROR, is_batch);
+	if (active_profiler != nullptr)
+		active_profiler->endPhase();
+
+	if (active_profiler != nullptr && !writeProfile(&config, active_profiler))
+		return finish(STATUS_EXPORT_ERROR, is_batch);
+
+	if (!is_batch)
+		cout << "Press a key to exit";
+
+	return finish(STATUS_OK, is_batch);
+}